@@ -70,9 +70,15 @@ enum ExecutorVersion : int32_t
 
 class TransactionExecutive;
 class BlockContext;
+class CoroutineStackPool;
+class ContractCodeCache;
+class CallResultCache;
+class PrecompiledRegistry;
 class PrecompiledContract;
 template <typename T, typename V>
 class ClockCache;
+template <class Hash, size_t Size>
+class BlockHashRing;
 struct FunctionAbi;
 struct CallParameters;
 
@@ -138,6 +144,46 @@ public:
 
     std::vector<std::string> getTxCriticals(const CallParameters& params);
 
+    // Byte budget of all uncommitted state storages, nextBlockHeader will be rejected with
+    // STATE_CAPACITY_EXCEEDED until commit releases enough state, 0 means unlimited
+    void setMaxUncommittedCapacity(size_t capacity) { m_maxUncommittedCapacity = capacity; }
+    size_t maxUncommittedCapacity() const { return m_maxUncommittedCapacity; }
+
+    // Sum of capacity() over all uncommitted state storages
+    size_t uncommittedCapacity();
+
+    // Number of the blocks whose state storage is not committed yet
+    size_t uncommittedBlocks();
+
+    // Execute evm transactions without coroutine if the called code has no CALL or CREATE opcode
+    void setLazyCoroutine(bool lazyCoroutine) { m_lazyCoroutine = lazyCoroutine; }
+    bool lazyCoroutine() const { return m_lazyCoroutine; }
+
+    // Usable stack size of the pooled coroutine stacks used by executives
+    void setCoroutineStackSize(size_t stackSize);
+    size_t coroutineStackSize() const;
+
+    // Bytes of the contract code cached across transactions, 0 disables the cache
+    void setCodeCacheCapacity(size_t capacity);
+    size_t codeCacheCapacity() const;
+    const std::shared_ptr<ContractCodeCache>& codeCache() const { return m_codeCache; }
+
+    // Rows read by a transaction cached by its executives, 0 (the default) disables the cache
+    void setStorageReadCacheRows(size_t rows) { m_storageReadCacheRows = rows; }
+    size_t storageReadCacheRows() const { return m_storageReadCacheRows; }
+
+    // Nested calls of call() executed by the executor itself up to the depth, without sending
+    // them to the scheduler, 0 (the default) disables it. Only call() is covered, transactions
+    // still send every nested call to the scheduler, which tracks key locks per contract.
+    void setMaxLocalCallDepth(size_t depth) { m_maxLocalCallDepth = depth; }
+    size_t maxLocalCallDepth() const { return m_maxLocalCallDepth; }
+
+    // Bytes of the results of calls cached until the next commit, 0 (the default) disables the
+    // cache
+    void setCallResultCacheCapacity(size_t capacity);
+    size_t callResultCacheCapacity() const;
+    const std::shared_ptr<CallResultCache>& callResultCache() const { return m_callResultCache; }
+
 private:
     std::shared_ptr<BlockContext> createBlockContext(
         const protocol::BlockHeader::ConstPtr& currentHeader,
@@ -147,6 +193,12 @@ private:
         h256 blockHash, uint64_t timestamp, int32_t blockVersion,
         storage::StateStorage::Ptr tableFactory);
 
+    // The hashes of the blocks before blockHeader, the previous ring with its parents added. The
+    // first time, without a previous ring, the 256 blocks are backfilled from the ledger.
+    std::shared_ptr<const BlockHashRing<h256, 256>> nextBlockHashes(
+        const protocol::BlockHeader::ConstPtr& blockHeader,
+        const std::shared_ptr<const BlockHashRing<h256, 256>>& previous);
+
     std::shared_ptr<TransactionExecutive> createExecutive(
         const std::shared_ptr<BlockContext>& _blockContext, const std::string& _contractAddress,
         int64_t contextID, int64_t seq);
@@ -159,6 +211,9 @@ private:
     std::unique_ptr<protocol::ExecutionMessage> toExecutionResult(
         const TransactionExecutive& executive, std::unique_ptr<CallParameters> params);
 
+    void releaseFinishedExecutive(BlockContext& blockContext,
+        const TransactionExecutive& executive, const CallParameters& output);
+
     std::unique_ptr<protocol::ExecutionMessage> toExecutionResult(
         std::unique_ptr<CallParameters> params);
 
@@ -166,7 +221,7 @@ private:
         bcos::protocol::ExecutionMessage& inputs, bool staticCall);
 
     std::unique_ptr<CallParameters> createCallParameters(
-        bcos::protocol::ExecutionMessage& input, const bcos::protocol::Transaction& tx);
+        bcos::protocol::ExecutionMessage& input, bcos::protocol::Transaction::ConstPtr tx);
 
     std::optional<std::vector<bcos::bytes>> decodeConflictFields(
         const FunctionAbi& functionAbi, const CallParameters& prams);
@@ -180,6 +235,11 @@ private:
 
     void removeCommittedState();
 
+    size_t uncommittedCapacityUnlocked() const;
+
+    void reportCapacityMetric(size_t capacity, size_t states);
+    void reportCacheMetric();
+
     void dagExecuteTransactionsForEvm(gsl::span<std::unique_ptr<CallParameters>> inputs,
         const bcos::crypto::HashList& txHashList,
         std::function<void(
@@ -216,6 +276,7 @@ private:
     std::list<State> m_stateStorages;
     bcos::storage::StorageInterface::Ptr m_lastStateStorage;
     bcos::protocol::BlockNumber m_lastCommittedBlockNumber = 1;
+    std::shared_ptr<const BlockHashRing<h256, 256>> m_blockHashes;  // guarded by the mutex below
 
     struct HashCombine
     {
@@ -242,13 +303,20 @@ private:
     };
     tbb::concurrent_hash_map<std::tuple<int64_t, int64_t>, CallState, HashCombine> m_calledContext;
     std::shared_mutex m_stateStoragesMutex;
+    size_t m_maxUncommittedCapacity = 0;
 
     std::shared_ptr<std::map<std::string, std::shared_ptr<PrecompiledContract>>>
         m_precompiledContract;
-    std::map<std::string, std::shared_ptr<precompiled::Precompiled>> m_constantPrecompiled;
+    std::shared_ptr<const PrecompiledRegistry> m_constantPrecompiled;
     std::shared_ptr<const std::set<std::string>> m_builtInPrecompiled;
     unsigned int m_DAGThreadNum = std::max(std::thread::hardware_concurrency(), (unsigned int)1);
     std::shared_ptr<wasm::GasInjector> m_gasInjector = nullptr;
+    std::shared_ptr<CoroutineStackPool> m_coroutineStackPool;
+    std::shared_ptr<ContractCodeCache> m_codeCache;
+    std::shared_ptr<CallResultCache> m_callResultCache;
+    bool m_lazyCoroutine = false;
+    size_t m_storageReadCacheRows = 0;
+    size_t m_maxLocalCallDepth = 0;
 };
 
 }  // namespace executor
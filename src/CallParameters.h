@@ -1,5 +1,6 @@
 #pragma once
 
+#include "executive/ObjectPool.h"
 #include "bcos-framework/libprotocol/LogEntry.h"
 #include "bcos-framework/libutilities/Common.h"
 #include <memory>
@@ -7,6 +8,81 @@
 
 namespace bcos::executor
 {
+// The data of a call, either owned or a view of an immutable buffer, e.g. the input of the
+// transaction or the memory of the caller frame. A view is copied on the first write, so the input
+// isn't copied by every layer it goes through.
+class CallData
+{
+public:
+    CallData() = default;
+    CallData(bytes data) : m_bytes(std::move(data)) {}
+
+    // Share the buffer of owner, the view must stay unchanged while owner is alive
+    CallData(std::shared_ptr<const void> owner, bytesConstRef view)
+      : m_owner(std::move(owner)), m_view(view), m_shared(true)
+    {}
+
+    // View of a buffer outliving the call data, e.g. the memory of a caller frame waiting for the
+    // callee, the data must be taken before the frame resumes
+    static CallData borrow(bytesConstRef view) { return CallData(nullptr, view); }
+
+    CallData(const CallData&) = default;
+    CallData(CallData&&) = default;
+    CallData& operator=(const CallData&) = default;
+    CallData& operator=(CallData&&) = default;
+
+    CallData& operator=(bytes data)
+    {
+        m_owner.reset();
+        m_view = bytesConstRef();
+        m_shared = false;
+        m_bytes = std::move(data);
+        return *this;
+    }
+
+    bool shared() const { return m_shared; }
+    // A view without owner, valid only as long as the frame it was borrowed from
+    bool borrowed() const { return m_shared && !m_owner; }
+
+    const byte* data() const { return shared() ? m_view.data() : m_bytes.data(); }
+    size_t size() const { return shared() ? m_view.size() : m_bytes.size(); }
+    bool empty() const { return size() == 0; }
+    const byte* begin() const { return data(); }
+    const byte* end() const { return data() + size(); }
+    bytesConstRef ref() const { return bytesConstRef(data(), size()); }
+
+    // Copy the shared buffer before writing
+    bytes& mutableBytes()
+    {
+        if (shared())
+        {
+            m_bytes.assign(m_view.begin(), m_view.end());
+            m_owner.reset();
+            m_view = bytesConstRef();
+            m_shared = false;
+        }
+        return m_bytes;
+    }
+
+    void assign(const byte* first, const byte* last) { *this = bytes(first, last); }
+    void clear() { *this = bytes(); }
+    void swap(bytes& other) { mutableBytes().swap(other); }
+
+    // Move the owned data out, or copy the shared buffer
+    bytes takeBytes()
+    {
+        auto data = std::move(mutableBytes());
+        m_bytes.clear();
+        return data;
+    }
+
+private:
+    bytes m_bytes;
+    std::shared_ptr<const void> m_owner;
+    bytesConstRef m_view;
+    bool m_shared = false;
+};
+
 struct CallParameters
 {
     using UniquePtr = std::unique_ptr<CallParameters>;
@@ -22,12 +98,15 @@ struct CallParameters
 
     explicit CallParameters(Type _type) : type(_type) {}
 
-    CallParameters(const CallParameters&) = delete;
     CallParameters& operator=(const CallParameters&) = delete;
 
     CallParameters(CallParameters&&) = delete;
     CallParameters(const CallParameters&&) = delete;
 
+    // Created and destroyed for every message, the memory is recycled by a thread local pool
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr, size_t size) noexcept;
+
     int64_t contextID = 0;
     int64_t seq = 0;
 
@@ -37,7 +116,7 @@ struct CallParameters
     std::string origin;          // common field, readable format
 
     int64_t gas = 0;   // common field
-    bcos::bytes data;  // common field, transaction data, binary format
+    CallData data;     // common field, transaction data, binary format
 
     std::vector<std::string> keyLocks;  // common field
     std::string acquireKeyLock;         // by response
@@ -51,5 +130,41 @@ struct CallParameters
     Type type;
     bool staticCall = false;  // common field
     bool create = false;      // by request, is create
+
+    // A copy of every field, the shared data isn't copied. The borrowed data is, the copy may
+    // outlive the caller frame
+    UniquePtr clone() const
+    {
+        auto copy = UniquePtr(new CallParameters(*this));
+        if (copy->data.borrowed())
+        {
+            copy->data.mutableBytes();
+        }
+        return copy;
+    }
+
+private:
+    CallParameters(const CallParameters&) = default;
 };
+
+using CallParametersPool = ThreadLocalBlockPool<sizeof(CallParameters)>;
+
+inline void* CallParameters::operator new(size_t size)
+{
+    if (size != sizeof(CallParameters))
+    {
+        return ::operator new(size);
+    }
+    return CallParametersPool::allocate();
+}
+
+inline void CallParameters::operator delete(void* ptr, size_t size) noexcept
+{
+    if (size != sizeof(CallParameters))
+    {
+        ::operator delete(ptr);
+        return;
+    }
+    CallParametersPool::deallocate(ptr);
+}
 }  // namespace bcos::executor
\ No newline at end of file
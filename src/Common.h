@@ -32,8 +32,11 @@
 #include "bcos-framework/libprotocol/TransactionStatus.h"
 #include "bcos-framework/libutilities/Exceptions.h"
 #include <evmc/instructions.h>
+#include <boost/algorithm/hex.hpp>
 #include <boost/algorithm/string/case_conv.hpp>
+#include <algorithm>
 #include <functional>
+#include <iterator>
 #include <set>
 
 namespace bcos
@@ -62,11 +65,14 @@ enum ExecuteError : int32_t
     ROLLBACK_ERROR,
     DAG_ERROR,
     DEAD_LOCK,
+    STATE_CAPACITY_EXCEEDED,
+    WRITE_IN_READ_ONLY,
 };
 
 static const char* const STORAGE_VALUE = "value";
 static const char* const ACCOUNT_CODE_HASH = "codeHash";
 static const char* const ACCOUNT_CODE = "code";
+static const char* const ACCOUNT_CODE_META = "codeMeta";
 static const char* const ACCOUNT_BALANCE = "balance";
 static const char* const ACCOUNT_ABI = "abi";
 static const char* const ACCOUNT_NONCE = "nonce";
@@ -313,6 +319,37 @@ inline evmc_address toEvmC(const std::string_view& _addr)
     return ret;
 }
 
+/**
+ * @brief : decode hex string address to evm address in place, without the temporary string of
+ * boost::algorithm::unhex
+ * @param _hexAddress : the hex string address without 0x prefix
+ * @return evmc_address : the transformed evm address
+ */
+inline evmc_address hexToEvmC(const std::string_view& _hexAddress)
+{
+    auto hexValue = [](char _c) -> uint8_t {
+        if (_c >= '0' && _c <= '9')
+            return _c - '0';
+        if (_c >= 'a' && _c <= 'f')
+            return _c - 'a' + 10;
+        if (_c >= 'A' && _c <= 'F')
+            return _c - 'A' + 10;
+        BOOST_THROW_EXCEPTION(boost::algorithm::non_hex_input());
+    };
+    if (_hexAddress.size() % 2 != 0)
+    {
+        BOOST_THROW_EXCEPTION(boost::algorithm::not_enough_input());
+    }
+
+    evmc_address ret{};
+    auto size = std::min(_hexAddress.size() / 2, sizeof(ret.bytes));
+    for (size_t i = 0; i < size; ++i)
+    {
+        ret.bytes[i] = (hexValue(_hexAddress[2 * i]) << 4) | hexValue(_hexAddress[2 * i + 1]);
+    }
+    return ret;
+}
+
 /**
  * @brief : trans ethereum hash to evm hash
  * @param _h : hash value
@@ -357,14 +394,17 @@ inline bytes toBytes(const std::string_view& _addr)
     return {(char*)_addr.data(), (char*)(_addr.data() + _addr.size())};
 }
 
-inline std::string getContractTableName(const std::string_view& _address)
+inline std::string getContractTableName(
+    const std::string_view& _address, const std::string_view& _prefix = "/apps/")
 {
-    std::string addressLower(_address);
-    boost::algorithm::to_lower(addressLower);
-
-    std::string address = (_address[0] == '/') ? addressLower.substr(1) : addressLower;
-
-    return std::string("/apps/").append(address);
+    auto address = (!_address.empty() && _address[0] == '/') ? _address.substr(1) : _address;
+
+    std::string tableName;
+    tableName.reserve(_prefix.size() + address.size());
+    tableName.append(_prefix);
+    std::transform(address.begin(), address.end(), std::back_inserter(tableName),
+        [](char c) { return (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c; });
+    return tableName;
 }
 
 }  // namespace bcos
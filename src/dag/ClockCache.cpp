@@ -30,10 +30,10 @@ using namespace std;
 using namespace bcos;
 using namespace bcos::executor;
 
-CacheItem* CacheShard::insert(size_t hash, void* value, bool holdReference)
+CacheItem* CacheShard::insert(size_t hash, void* value, size_t charge, bool holdReference)
 {
     auto guard = lock_guard<mutex>(m_mutex);
-    auto success = evictFromCache();
+    auto success = evictFromCache(charge);
     if (!success)
     {
         return nullptr;
@@ -55,6 +55,7 @@ CacheItem* CacheShard::insert(size_t hash, void* value, bool holdReference)
 
     item->hash = hash;
     item->value = value;
+    item->charge = charge;
     auto flags = holdReference ? s_inCacheBit + s_oneRef : s_inCacheBit;
 
     item->flags.store(flags, std::memory_order_relaxed);
@@ -66,7 +67,7 @@ CacheItem* CacheShard::insert(size_t hash, void* value, bool holdReference)
         unsetInCache(existingHandle);
     }
     m_table.insert(HashTable::value_type(hash, item));
-    m_usage.fetch_add(1, std::memory_order_relaxed);
+    m_usage.fetch_add(charge, std::memory_order_relaxed);
     return item;
 }
 
@@ -154,11 +155,15 @@ void CacheShard::unsetInCache(CacheItem* item)
     }
 }
 
-bool CacheShard::evictFromCache()
+bool CacheShard::evictFromCache(size_t charge)
 {
     assert(!m_mutex.try_lock());
     auto usage = m_usage.load(std::memory_order_relaxed);
     auto capacity = m_capacity.load(memory_order_relaxed);
+    if (charge > capacity)
+    {
+        return false;
+    }
     if (usage == 0)
     {
         return true;
@@ -166,7 +171,7 @@ bool CacheShard::evictFromCache()
 
     auto newHead = m_head;
     bool is2ndIteration = false;
-    while (usage >= capacity)
+    while (usage + charge > capacity)
     {
         assert(newHead < m_list.size());
         auto evicted = tryEvict(&m_list[newHead]);
@@ -217,7 +222,7 @@ void CacheShard::recycleItem(CacheItem* item)
     assert(!inCache(flags) && refCounts(flags) == 0);
     m_deleter(item->value);
     m_recycle.push_back(item);
-    m_usage.fetch_sub(1, std::memory_order_relaxed);
+    m_usage.fetch_sub(item->charge, std::memory_order_relaxed);
 }
 
 void CacheShard::setCapacity(size_t capacity)
@@ -225,7 +230,7 @@ void CacheShard::setCapacity(size_t capacity)
     assert(capacity > 0);
     auto guard = lock_guard<mutex>(m_mutex);
     m_capacity.store(capacity, std::memory_order_relaxed);
-    evictFromCache();
+    evictFromCache(0);
 }
 
 CacheShard::~CacheShard()
@@ -49,6 +49,7 @@ struct CacheItem
     CacheItem& operator=(const CacheItem& a)
     {
         value = a.value;
+        charge = a.charge;
         return *this;
     }
 
@@ -56,6 +57,9 @@ struct CacheItem
 
     void* value;
 
+    // The share of the cache capacity used by the value, 1 for caches bounded by count
+    size_t charge;
+
     // Flags and counters associated with the cache item:
     //   lowest bit: in-cache bit
     //   second lowest bit: usage bit
@@ -69,13 +73,13 @@ struct CacheItem
 class CacheShard
 {
 public:
-    using HashTable = tbb::concurrent_hash_map<uint32_t, CacheItem*>;
+    using HashTable = tbb::concurrent_hash_map<size_t, CacheItem*>;
     using Deleter = void (*)(void* value);
 
     CacheShard() : m_head(0), m_usage(0) {}
 
-    // Insert a mapping from key->value into the cache.
-    CacheItem* insert(size_t hash, void* value, bool holdReference);
+    // Insert a mapping from key->value into the cache, the value takes charge of the capacity.
+    CacheItem* insert(size_t hash, void* value, size_t charge, bool holdReference);
 
     // If the cache has no mapping for "key", returns nullptr, otherwise return a
     // item that corresponds to the mapping. The caller must call this->unref(item)
@@ -98,6 +102,8 @@ public:
 
     void setCapacity(size_t capacity);
 
+    size_t usage() const { return m_usage.load(std::memory_order_relaxed); }
+
     void setDeleter(Deleter deleter) { m_deleter = deleter; }
 
     ~CacheShard();
@@ -119,10 +125,10 @@ private:
     void unsetInCache(CacheItem* item);
 
     // Scan through the circular list, evict entries until we get enough space
-    // for a new cache entry. Return true if success, false otherwise.
+    // for a new cache entry of the charge. Return true if success, false otherwise.
     //
     // Has to hold mutex_ before being called.
-    bool evictFromCache();
+    bool evictFromCache(size_t charge);
 
     // Examine the item for eviction. If the item is in cache, usage bit is
     // not set, and referece count is 0, evict it from cache. Otherwise unset
@@ -188,10 +194,6 @@ public:
 
     CacheHandle(CacheHandle&& a)
     {
-        if (isValid())
-        {
-            m_ownedShard->unref(m_item, true);
-        }
         m_item = a.m_item;
         m_ownedShard = a.m_ownedShard;
         a.m_item = nullptr;
@@ -239,8 +241,8 @@ public:
     bool isValid() const { return m_item != nullptr && m_ownedShard != nullptr; }
 
 private:
-    CacheItem* m_item;
-    CacheShard* m_ownedShard;
+    CacheItem* m_item = nullptr;
+    CacheShard* m_ownedShard = nullptr;
 };
 
 template <typename K, typename V>
@@ -274,12 +276,14 @@ public:
         return CacheHandle<V>(item, &ownedShard);
     }
 
-    bool insert(const K& key, V* value, CacheHandle<V>* outHandle = nullptr)
+    // The capacity of every shard is counted by charge, which is 1 for the caches bounded by the
+    // number of entries, or the memory size of the value for the caches bounded by bytes
+    bool insert(const K& key, V* value, CacheHandle<V>* outHandle = nullptr, size_t charge = 1)
     {
         auto hasher = boost::hash<K>();
         auto hash = hasher(key);
         auto& shard = getShard(hash);
-        auto item = shard.insert(hash, value, outHandle != nullptr);
+        auto item = shard.insert(hash, value, charge, outHandle != nullptr);
         if (outHandle != nullptr)
         {
             if (item != nullptr)
@@ -290,6 +294,17 @@ public:
         return item != nullptr;
     }
 
+    // The total charge of the values in all shards
+    size_t usage() const
+    {
+        size_t usage = 0;
+        for (auto i = 0u; i < m_numShards; ++i)
+        {
+            usage += m_shards[i].usage();
+        }
+        return usage;
+    }
+
     ~ClockCache() { delete[] m_shards; }
 
 private:
@@ -31,9 +31,8 @@ DAG::~DAG()
 
 void DAG::init(ID _maxSize)
 {
-    clear();
-    for (ID i = 0; i < _maxSize; ++i)
-        m_vtxs.emplace_back(make_shared<Vertex>());
+    // All the vertices in one allocation
+    m_vtxs = std::vector<Vertex>(_maxSize);
     m_totalVtxs = _maxSize;
     m_totalConsume = 0;
 }
@@ -42,8 +41,8 @@ void DAG::addEdge(ID _f, ID _t)
 {
     if (_f >= m_vtxs.size() && _t >= m_vtxs.size())
         return;
-    m_vtxs[_f]->outEdge.emplace_back(_t);
-    m_vtxs[_t]->inDegree += 1;
+    m_vtxs[_f].outEdge.emplace_back(_t);
+    m_vtxs[_t].inDegree += 1;
     // PARA_LOG(TRACE) << LOG_BADGE("DAG") << LOG_DESC("Add edge") << LOG_KV("from", _f)
     //                << LOG_KV("to", _t);
 }
@@ -52,7 +51,7 @@ void DAG::generate()
 {
     for (ID id = 0; id < m_vtxs.size(); ++id)
     {
-        if (m_vtxs[id]->inDegree == 0)
+        if (m_vtxs[id].inDegree == 0)
             m_topLevel.push(id);
     }
 
@@ -100,11 +99,11 @@ ID DAG::consume(ID _id)
     ID producedNum = 0;
     ID nextId = INVALID_ID;
     ID lastDegree = INVALID_ID;
-    for (ID id : m_vtxs[_id]->outEdge)
+    for (ID id : m_vtxs[_id].outEdge)
     {
-        auto vtx = m_vtxs[id];
+        auto& vtx = m_vtxs[id];
         {
-            lastDegree = vtx->inDegree.fetch_sub(1);
+            lastDegree = vtx.inDegree.fetch_sub(1);
         }
         if (lastDegree == 1)
         {
@@ -134,15 +133,15 @@ ID DAG::consume(ID _id)
 
 void DAG::clear()
 {
-    m_vtxs = std::vector<std::shared_ptr<Vertex>>();
+    m_vtxs = std::vector<Vertex>();
     // XXXX m_topLevel.clear();
 }
 
 void DAG::printVtx(ID _id)
 {
-    for (ID id : m_vtxs[_id]->outEdge)
+    for (ID id : m_vtxs[_id].outEdge)
     {
         PARA_LOG(TRACE) << LOG_BADGE("DAG") << LOG_DESC("VertexEdge") << LOG_KV("ID", _id)
-                        << LOG_KV("inDegree", m_vtxs[_id]->inDegree) << LOG_KV("edge", id);
+                        << LOG_KV("inDegree", m_vtxs[_id].inDegree) << LOG_KV("edge", id);
     }
 }
\ No newline at end of file
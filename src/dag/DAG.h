@@ -40,7 +40,7 @@ static const ID INVALID_ID = (ID(0) - 1);
 
 struct Vertex
 {
-    std::atomic<ID> inDegree;
+    std::atomic<ID> inDegree = 0;
     std::vector<ID> outEdge;
 };
 
@@ -71,7 +71,7 @@ public:
     void clear();
 
 private:
-    std::vector<std::shared_ptr<Vertex>> m_vtxs;
+    std::vector<Vertex> m_vtxs;
     tbb::concurrent_queue<ID> m_topLevel;
 
     ID m_totalVtxs = 0;
@@ -81,7 +81,7 @@ void TxDAG::setTxExecuteFunc(ExecuteTxFunc const& _f)
     f_executeTx = _f;
 }
 
-int TxDAG::executeUnit(const vector<TransactionExecutive::Ptr>& allExecutives,
+int TxDAG::executeUnit(vector<TransactionExecutive::Ptr>& allExecutives,
     vector<std::unique_ptr<CallParameters>>& allCallParameters,
     const std::vector<gsl::index>& allIndex)
 {
@@ -94,7 +94,8 @@ int TxDAG::executeUnit(const vector<TransactionExecutive::Ptr>& allExecutives,
             exeCnt += 1;
             if (allExecutives[id] && allCallParameters.at(id))
             {
-                f_executeTx(allExecutives[id], std::move(allCallParameters.at(id)), allIndex[id]);
+                f_executeTx(std::move(allExecutives[id]), std::move(allCallParameters.at(id)),
+                    allIndex[id]);
             }
             id = m_dag.consume(id);
         } while (id != INVALID_ID);
@@ -80,8 +80,8 @@ public:
 
     // Called by thread
     // Execute a unit in DAG
-    // This function can be parallel
-    int executeUnit(const std::vector<TransactionExecutive::Ptr>& allExecutives,
+    // This function can be parallel, executed executives are moved out of allExecutives
+    int executeUnit(std::vector<TransactionExecutive::Ptr>& allExecutives,
         std::vector<std::unique_ptr<CallParameters>>& allCallParameters,
         const std::vector<gsl::index>& allIndex);
 
@@ -64,27 +64,41 @@ BlockContext::BlockContext(std::shared_ptr<storage::StateStorage> storage,
     m_lastStorage = std::move(_lastStorage);
 }
 
+h256 BlockContext::blockHash(int64_t number) const
+{
+    if (!m_blockHashes || number >= m_blockNumber ||
+        number < m_blockNumber - static_cast<int64_t>(BlockHashes::size()))
+    {
+        return h256();
+    }
+
+    auto hash = m_blockHashes->get(number);
+    return hash ? *hash : h256();
+}
+
 void BlockContext::insertExecutive(int64_t contextID, int64_t seq, ExecutiveState state)
 {
-    auto it = m_executives.find(std::tuple{contextID, seq});
-    if (it != m_executives.end())
+    auto success = m_executives.emplace(std::tuple{contextID, seq}, std::move(state));
+    if (!success)
     {
         BOOST_THROW_EXCEPTION(
             BCOS_ERROR(-1, "Executive exists: " + boost::lexical_cast<std::string>(contextID)));
     }
-
-    bool success;
-    std::tie(it, success) = m_executives.emplace(std::tuple{contextID, seq}, std::move(state));
 }
 
-bcos::executor::BlockContext::ExecutiveState* BlockContext::getExecutive(
+std::optional<bcos::executor::BlockContext::ExecutiveState> BlockContext::getExecutive(
     int64_t contextID, int64_t seq)
 {
-    auto it = m_executives.find({contextID, seq});
-    if (it == m_executives.end())
+    decltype(m_executives)::const_accessor it;
+    if (!m_executives.find(it, std::tuple{contextID, seq}))
     {
-        return nullptr;
+        return std::nullopt;
     }
 
-    return &it->second;
+    return it->second;
+}
+
+bool BlockContext::eraseExecutive(int64_t contextID, int64_t seq)
+{
+    return m_executives.erase(std::tuple{contextID, seq});
 }
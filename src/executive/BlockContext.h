@@ -22,16 +22,18 @@
 #pragma once
 
 #include "../Common.h"
+#include "BlockHashRing.h"
 #include "bcos-framework/interfaces/executor/ExecutionMessage.h"
 #include "bcos-framework/interfaces/protocol/Block.h"
 #include "bcos-framework/interfaces/protocol/Transaction.h"
 #include "bcos-framework/interfaces/storage/Table.h"
 #include "bcos-framework/libstorage/StateStorage.h"
 #include "interfaces/protocol/ProtocolTypeDef.h"
-#include <tbb/concurrent_unordered_map.h>
+#include <tbb/concurrent_hash_map.h>
 #include <atomic>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <stack>
 #include <string_view>
 
@@ -46,6 +48,7 @@ class BlockContext : public std::enable_shared_from_this<BlockContext>
 {
 public:
     typedef std::shared_ptr<BlockContext> Ptr;
+    using BlockHashes = BlockHashRing<h256>;
 
     BlockContext(std::shared_ptr<storage::StateStorage> storage, crypto::Hash::Ptr _hashImpl,
         bcos::protocol::BlockNumber blockNumber, h256 blockHash, uint64_t timestamp,
@@ -75,12 +78,20 @@ public:
     bool isAuthCheck() const { return m_isAuthCheck; }
     int64_t number() const { return m_blockNumber; }
     h256 hash() const { return m_blockHash; }
+    // Hash of one of the 256 blocks before this block, h256() for the other blocks or if unknown
+    h256 blockHash(int64_t number) const;
     uint64_t timestamp() const { return m_timeStamp; }
     int32_t blockVersion() const { return m_blockVersion; }
     u256 const& gasLimit() const { return m_gasLimit; }
 
     EVMSchedule const& evmSchedule() const { return m_schedule; }
 
+    // Hashes of the recent blocks, the ring must not be modified once set
+    void setBlockHashes(BlockHashes::ConstPtr blockHashes)
+    {
+        m_blockHashes = std::move(blockHashes);
+    }
+
     struct ExecutiveState
     {
         std::shared_ptr<TransactionExecutive> executive;
@@ -88,14 +99,19 @@ public:
 
     void insertExecutive(int64_t contextID, int64_t seq, ExecutiveState state);
 
-    ExecutiveState* getExecutive(int64_t contextID, int64_t seq);
+    std::optional<ExecutiveState> getExecutive(int64_t contextID, int64_t seq);
+
+    // Release a finished or reverted executive, so the block only holds in-flight executives
+    bool eraseExecutive(int64_t contextID, int64_t seq);
+
+    size_t executivesSize() const { return m_executives.size(); }
 
     void clear() { m_executives.clear(); }
 
 private:
     struct HashCombine
     {
-        size_t operator()(const std::tuple<int64_t, int64_t>& val) const
+        size_t hash(const std::tuple<int64_t, int64_t>& val) const
         {
             size_t seed = hashInt64(std::get<0>(val));
             boost::hash_combine(seed, hashInt64(std::get<1>(val)));
@@ -103,11 +119,18 @@ private:
             return seed;
         }
 
+        bool equal(
+            const std::tuple<int64_t, int64_t>& lhs, const std::tuple<int64_t, int64_t>& rhs) const
+        {
+            return std::get<0>(lhs) == std::get<0>(rhs) && std::get<1>(lhs) == std::get<1>(rhs);
+        }
+
         std::hash<int64_t> hashInt64;
     };
 
-    tbb::concurrent_unordered_map<std::tuple<int64_t, int64_t>, ExecutiveState, HashCombine>
+    tbb::concurrent_hash_map<std::tuple<int64_t, int64_t>, ExecutiveState, HashCombine>
         m_executives;
+    BlockHashes::ConstPtr m_blockHashes;
 
     bcos::protocol::BlockNumber m_blockNumber;
     h256 m_blockHash;
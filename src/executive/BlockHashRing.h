@@ -0,0 +1,82 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief hashes of the recent blocks, for the BLOCKHASH opcode
+ * @file BlockHashRing.h
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace bcos
+{
+namespace executor
+{
+// The hashes of the last Size blocks, block n is in the slot n % Size. A slot keeps the number of
+// its block, so the hash of a block overwritten by a later one, or never inserted, isn't returned.
+// The ring isn't thread safe, the executor copies it for each block and the block contexts only
+// read their copy.
+template <class Hash, size_t Size = 256>
+class BlockHashRing
+{
+public:
+    using Ptr = std::shared_ptr<BlockHashRing>;
+    using ConstPtr = std::shared_ptr<const BlockHashRing>;
+
+    static constexpr size_t size() { return Size; }
+
+    void insert(int64_t number, const Hash& hash)
+    {
+        if (number < 0)
+        {
+            return;
+        }
+
+        auto& slot = m_slots[number % Size];
+        slot.number = number;
+        slot.hash = hash;
+    }
+
+    std::optional<Hash> get(int64_t number) const
+    {
+        if (!contains(number))
+        {
+            return std::nullopt;
+        }
+        return m_slots[number % Size].hash;
+    }
+
+    bool contains(int64_t number) const
+    {
+        return number >= 0 && m_slots[number % Size].number == number;
+    }
+
+private:
+    struct Slot
+    {
+        int64_t number = -1;
+        Hash hash{};
+    };
+
+    std::array<Slot, Size> m_slots;
+};
+
+}  // namespace executor
+}  // namespace bcos
@@ -0,0 +1,90 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief pool of fixed size, guard paged coroutine stacks shared by executives
+ * @file CoroutineStackPool.cpp
+ */
+
+#include "CoroutineStackPool.h"
+#include <sys/mman.h>
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+using namespace bcos::executor;
+
+CoroutineStackPool::CoroutineStackPool(size_t stackSize, size_t maxCachedStacks)
+  : m_pageSize(boost::context::stack_traits::page_size()), m_maxCachedStacks(maxCachedStacks)
+{
+    m_stackSize = std::max(stackSize, boost::context::stack_traits::minimum_size());
+    m_stackSize = (m_stackSize + m_pageSize - 1) / m_pageSize * m_pageSize;
+    m_mappedSize = m_stackSize + m_pageSize;
+}
+
+CoroutineStackPool::~CoroutineStackPool()
+{
+    void* stack = nullptr;
+    while (m_freeStacks.try_pop(stack))
+    {
+        ::munmap(stack, m_mappedSize);
+    }
+}
+
+boost::context::stack_context CoroutineStackPool::allocate()
+{
+    void* stack = nullptr;
+    if (m_freeStacks.try_pop(stack))
+    {
+        --m_cachedStacks;
+    }
+    else
+    {
+        stack = ::mmap(
+            nullptr, m_mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (stack == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+
+        // Stacks grow downwards, protect the lowest page to catch overflow
+        if (::mprotect(stack, m_pageSize, PROT_NONE) != 0)
+        {
+            ::munmap(stack, m_mappedSize);
+            throw std::bad_alloc();
+        }
+    }
+
+    boost::context::stack_context context;
+    context.size = m_mappedSize;
+    context.sp = static_cast<char*>(stack) + m_mappedSize;
+    return context;
+}
+
+void CoroutineStackPool::deallocate(boost::context::stack_context& context) noexcept
+{
+    assert(context.sp);
+    assert(context.size == m_mappedSize);
+
+    void* stack = static_cast<char*>(context.sp) - context.size;
+    if (m_cachedStacks.fetch_add(1) < m_maxCachedStacks)
+    {
+        m_freeStacks.push(stack);
+    }
+    else
+    {
+        --m_cachedStacks;
+        ::munmap(stack, m_mappedSize);
+    }
+}
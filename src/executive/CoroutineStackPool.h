@@ -0,0 +1,83 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief pool of fixed size, guard paged coroutine stacks shared by executives
+ * @file CoroutineStackPool.h
+ */
+
+#pragma once
+
+#include <tbb/concurrent_queue.h>
+#include <boost/context/stack_context.hpp>
+#include <boost/context/stack_traits.hpp>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace bcos
+{
+namespace executor
+{
+class CoroutineStackPool : public std::enable_shared_from_this<CoroutineStackPool>
+{
+public:
+    using Ptr = std::shared_ptr<CoroutineStackPool>;
+
+    // stackSize excludes the guard page, it is rounded up to the page size
+    CoroutineStackPool(size_t stackSize = boost::context::stack_traits::default_size(),
+        size_t maxCachedStacks = 256);
+
+    CoroutineStackPool(const CoroutineStackPool&) = delete;
+    CoroutineStackPool& operator=(const CoroutineStackPool&) = delete;
+
+    ~CoroutineStackPool();
+
+    boost::context::stack_context allocate();
+    void deallocate(boost::context::stack_context& stack) noexcept;
+
+    size_t stackSize() const { return m_stackSize; }
+    size_t cachedStacks() const { return m_cachedStacks.load(); }
+
+    // Satisfy the StackAllocator concept of boost::coroutines2, keep the pool alive until the last
+    // coroutine which allocated from it is destroyed
+    class Allocator
+    {
+    public:
+        explicit Allocator(Ptr pool) : m_pool(std::move(pool)) {}
+
+        boost::context::stack_context allocate() { return m_pool->allocate(); }
+        void deallocate(boost::context::stack_context& stack) noexcept
+        {
+            m_pool->deallocate(stack);
+        }
+
+    private:
+        Ptr m_pool;
+    };
+
+    Allocator allocator() { return Allocator(shared_from_this()); }
+
+private:
+    size_t m_pageSize;
+    size_t m_stackSize;  // usable size
+    size_t m_mappedSize;  // usable size plus the guard page
+    size_t m_maxCachedStacks;
+
+    std::atomic<size_t> m_cachedStacks = 0;
+    tbb::concurrent_queue<void*> m_freeStacks;
+};
+
+}  // namespace executor
+}  // namespace bcos
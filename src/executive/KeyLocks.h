@@ -0,0 +1,212 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief set of the key locks of a transaction, qualified by table
+ * @file KeyLocks.h
+ */
+
+#pragma once
+
+#include "TableNameInterner.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bcos
+{
+namespace executor
+{
+// Key locks are identified by (hash of the table name, key). Locks exchanged with the scheduler
+// are encoded as the 8 bytes big endian table hash followed by the key.
+class KeyLockSet
+{
+public:
+    static constexpr size_t c_tableHashSize = sizeof(uint64_t);
+
+    static std::string encode(uint64_t tableHash, std::string_view key)
+    {
+        std::string keyLock(c_tableHashSize + key.size(), '\0');
+        for (size_t i = 0; i < c_tableHashSize; ++i)
+        {
+            keyLock[i] = static_cast<char>(tableHash >> ((c_tableHashSize - 1 - i) * 8));
+        }
+        keyLock.replace(c_tableHashSize, key.size(), key.data(), key.size());
+        return keyLock;
+    }
+
+    static std::string encode(std::string_view table, std::string_view key)
+    {
+        return encode(hashTableName(table), key);
+    }
+
+    // Return false if the key lock is shorter than the table hash
+    static bool decode(std::string_view keyLock, uint64_t& tableHash, std::string_view& key)
+    {
+        if (keyLock.size() < c_tableHashSize)
+        {
+            return false;
+        }
+        tableHash = 0;
+        for (size_t i = 0; i < c_tableHashSize; ++i)
+        {
+            tableHash = (tableHash << 8) | static_cast<uint8_t>(keyLock[i]);
+        }
+        key = keyLock.substr(c_tableHashSize);
+        return true;
+    }
+
+    bool contains(uint64_t tableHash, std::string_view key) const
+    {
+        if (m_size == 0)
+        {
+            return false;
+        }
+        auto hash = hashOf(tableHash, key);
+        auto mask = m_slots.size() - 1;
+        for (auto i = hash & mask;; i = (i + 1) & mask)
+        {
+            auto& slot = m_slots[i];
+            if (slot.hash == 0)
+            {
+                return false;
+            }
+            if (slot.hash == hash && slot.tableHash == tableHash && slot.key == key)
+            {
+                return true;
+            }
+        }
+    }
+
+    // Return true if the key lock wasn't in the set
+    bool insert(uint64_t tableHash, std::string_view key)
+    {
+        if (contains(tableHash, key))
+        {
+            return false;
+        }
+
+        // Keep the load factor under 3/4 to bound the probe length
+        if ((m_size + 1) > m_slots.size() / 4 * 3)
+        {
+            grow();
+        }
+
+        auto hash = hashOf(tableHash, key);
+        auto& slot = emptySlot(hash);
+        slot.hash = hash;
+        slot.tableHash = tableHash;
+        slot.key.assign(key.data(), key.size());
+        ++m_size;
+        return true;
+    }
+
+    // Insert an encoded key lock, malformed ones are ignored
+    bool insertEncoded(std::string_view keyLock)
+    {
+        uint64_t tableHash;
+        std::string_view key;
+        if (!decode(keyLock, tableHash, key))
+        {
+            return false;
+        }
+        return insert(tableHash, key);
+    }
+
+    template <class F>
+    void forEach(F&& f) const
+    {
+        for (auto& slot : m_slots)
+        {
+            if (slot.hash != 0)
+            {
+                f(slot.tableHash, std::string_view(slot.key));
+            }
+        }
+    }
+
+    // Encode the key locks and clear the set
+    std::vector<std::string> exportEncoded()
+    {
+        std::vector<std::string> keyLocks;
+        keyLocks.reserve(m_size);
+        forEach([&keyLocks](uint64_t tableHash, std::string_view key) {
+            keyLocks.emplace_back(encode(tableHash, key));
+        });
+        clear();
+        return keyLocks;
+    }
+
+    void clear()
+    {
+        if (m_size == 0)
+        {
+            return;
+        }
+        for (auto& slot : m_slots)
+        {
+            slot.hash = 0;
+        }
+        m_size = 0;
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+private:
+    struct Slot
+    {
+        size_t hash = 0;  // 0 is an empty slot
+        uint64_t tableHash = 0;
+        std::string key;
+    };
+
+    static size_t hashOf(uint64_t tableHash, std::string_view key)
+    {
+        auto hash = std::hash<std::string_view>{}(key) ^ (tableHash * 0x9e3779b97f4a7c15ULL);
+        return hash != 0 ? hash : 1;
+    }
+
+    Slot& emptySlot(size_t hash)
+    {
+        auto mask = m_slots.size() - 1;
+        auto i = hash & mask;
+        while (m_slots[i].hash != 0)
+        {
+            i = (i + 1) & mask;
+        }
+        return m_slots[i];
+    }
+
+    void grow()
+    {
+        std::vector<Slot> slots(m_slots.empty() ? 16 : m_slots.size() * 2);
+        std::swap(slots, m_slots);
+        for (auto& slot : slots)
+        {
+            if (slot.hash != 0)
+            {
+                emptySlot(slot.hash) = std::move(slot);
+            }
+        }
+    }
+
+    std::vector<Slot> m_slots;
+    size_t m_size = 0;
+};
+
+}  // namespace executor
+}  // namespace bcos
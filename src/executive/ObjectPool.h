@@ -0,0 +1,105 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief thread local pool of fixed size blocks for the objects created for every message
+ * @file ObjectPool.h
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace bcos
+{
+namespace executor
+{
+// Every thread keeps a free list of at most MaxCachedBlocks blocks, no lock is taken. A block freed
+// by another thread than the one allocated it joins the list of the freeing thread, the blocks are
+// plain ::operator new blocks so they can be released by any thread.
+template <size_t BlockSize, size_t MaxCachedBlocks = 1024>
+class ThreadLocalBlockPool
+{
+public:
+    static_assert(BlockSize >= sizeof(void*), "A free block holds the pointer to the next one");
+
+    static void* allocate()
+    {
+        auto& list = freeList();
+        if (list.head)
+        {
+            auto block = list.head;
+            list.head = *static_cast<void**>(block);
+            --list.size;
+            return block;
+        }
+        return ::operator new(BlockSize);
+    }
+
+    static void deallocate(void* block) noexcept
+    {
+        // The list is gone while the thread exits
+        if (t_exited)
+        {
+            ::operator delete(block);
+            return;
+        }
+
+        auto& list = freeList();
+        if (list.size >= MaxCachedBlocks)
+        {
+            ::operator delete(block);
+            return;
+        }
+        *static_cast<void**>(block) = list.head;
+        list.head = block;
+        ++list.size;
+    }
+
+    // The blocks cached by the calling thread
+    static size_t cachedBlocks() { return t_exited ? 0 : freeList().size; }
+
+private:
+    struct FreeList
+    {
+        ~FreeList()
+        {
+            t_exited = true;
+            while (head)
+            {
+                auto block = head;
+                head = *static_cast<void**>(block);
+                ::operator delete(block);
+            }
+        }
+
+        void* head = nullptr;
+        size_t size = 0;
+    };
+
+    static FreeList& freeList()
+    {
+        thread_local FreeList list;
+        return list;
+    }
+
+    static thread_local bool t_exited;
+};
+
+template <size_t BlockSize, size_t MaxCachedBlocks>
+thread_local bool ThreadLocalBlockPool<BlockSize, MaxCachedBlocks>::t_exited = false;
+
+}  // namespace executor
+}  // namespace bcos
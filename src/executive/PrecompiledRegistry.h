@@ -0,0 +1,72 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief immutable registry of the constant precompiled contracts, shared by all executives
+ * @file PrecompiledRegistry.h
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace bcos
+{
+namespace precompiled
+{
+class Precompiled;
+}
+
+namespace executor
+{
+class PrecompiledRegistry
+{
+public:
+    using Ptr = std::shared_ptr<const PrecompiledRegistry>;
+    using PrecompiledMap =
+        std::unordered_map<std::string, std::shared_ptr<precompiled::Precompiled>>;
+
+    // The key is the precompiled address in evm, or the precompiled name in wasm
+    explicit PrecompiledRegistry(PrecompiledMap precompiled) : m_precompiled(std::move(precompiled))
+    {}
+
+    PrecompiledRegistry(const PrecompiledRegistry&) = delete;
+    PrecompiledRegistry& operator=(const PrecompiledRegistry&) = delete;
+
+    // Return a reference into the registry to avoid touching the reference count
+    const std::shared_ptr<precompiled::Precompiled>* find(const std::string& address) const
+    {
+        auto it = m_precompiled.find(address);
+        if (it == m_precompiled.end())
+        {
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    bool contains(const std::string& address) const
+    {
+        return m_precompiled.find(address) != m_precompiled.end();
+    }
+
+    size_t size() const { return m_precompiled.size(); }
+
+private:
+    const PrecompiledMap m_precompiled;
+};
+
+}  // namespace executor
+}  // namespace bcos
@@ -0,0 +1,179 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief small open addressing cache of the rows read by one transaction
+ * @file StorageReadCache.h
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bcos
+{
+namespace executor
+{
+// Rows keyed by (interned table id, key), only used by a single executive so it isn't thread
+// safe. Clear is O(1), the slots and their key buffers are reused by the next rows.
+template <class Value>
+class StorageReadCache
+{
+public:
+    static constexpr size_t c_initialSlots = 16;
+
+    // maxRows is rounded up to a power of two, the table grows from c_initialSlots slots and is
+    // cleared when it is full at the max size
+    explicit StorageReadCache(size_t maxRows) : m_maxSlots(c_initialSlots)
+    {
+        while (m_maxSlots / 4 * 3 < maxRows)
+        {
+            m_maxSlots <<= 1;
+        }
+        m_slots.resize(c_initialSlots);
+    }
+
+    StorageReadCache(const StorageReadCache&) = delete;
+    StorageReadCache& operator=(const StorageReadCache&) = delete;
+
+    // The cached value may be updated in place
+    Value* find(uint32_t table, std::string_view key)
+    {
+        auto hash = hashOf(table, key);
+        auto mask = m_slots.size() - 1;
+        for (auto i = hash & mask;; i = (i + 1) & mask)
+        {
+            auto& slot = m_slots[i];
+            if (slot.generation != m_generation)
+            {
+                ++m_misses;
+                return nullptr;
+            }
+            if (slot.hash == hash && slot.table == table && slot.key == key)
+            {
+                ++m_hits;
+                return &slot.value;
+            }
+        }
+    }
+
+    // Insert the row or overwrite the cached one
+    void insert(uint32_t table, std::string_view key, Value value)
+    {
+        auto hash = hashOf(table, key);
+        auto mask = m_slots.size() - 1;
+        for (auto i = hash & mask;; i = (i + 1) & mask)
+        {
+            auto& slot = m_slots[i];
+            if (slot.generation != m_generation)
+            {
+                break;
+            }
+            if (slot.hash == hash && slot.table == table && slot.key == key)
+            {
+                slot.value = std::move(value);
+                return;
+            }
+        }
+
+        // Keep the load factor under 3/4 to bound the probe length
+        if ((m_size + 1) > m_slots.size() / 4 * 3)
+        {
+            if (m_slots.size() < m_maxSlots)
+            {
+                grow();
+            }
+            else
+            {
+                clear();
+            }
+        }
+
+        auto& slot = emptySlot(hash);
+        slot.generation = m_generation;
+        slot.hash = hash;
+        slot.table = table;
+        slot.key.assign(key.data(), key.size());
+        slot.value = std::move(value);
+        ++m_size;
+    }
+
+    void clear()
+    {
+        if (m_size == 0)
+        {
+            return;
+        }
+        ++m_generation;
+        m_size = 0;
+    }
+
+    size_t size() const { return m_size; }
+    size_t slots() const { return m_slots.size(); }
+    size_t hits() const { return m_hits; }
+    size_t misses() const { return m_misses; }
+
+private:
+    struct Slot
+    {
+        uint64_t generation = 0;  // the slot is used if it matches m_generation
+        size_t hash = 0;
+        uint32_t table = 0;
+        std::string key;
+        Value value;
+    };
+
+    static size_t hashOf(uint32_t table, std::string_view key)
+    {
+        return std::hash<std::string_view>{}(key) ^ (table * 0x9e3779b97f4a7c15ULL);
+    }
+
+    Slot& emptySlot(size_t hash)
+    {
+        auto mask = m_slots.size() - 1;
+        auto i = hash & mask;
+        while (m_slots[i].generation == m_generation)
+        {
+            i = (i + 1) & mask;
+        }
+        return m_slots[i];
+    }
+
+    void grow()
+    {
+        std::vector<Slot> slots(m_slots.size() * 2);
+        std::swap(slots, m_slots);
+        for (auto& slot : slots)
+        {
+            if (slot.generation == m_generation)
+            {
+                emptySlot(slot.hash) = std::move(slot);
+            }
+        }
+    }
+
+    std::vector<Slot> m_slots;
+    size_t m_maxSlots;
+    size_t m_size = 0;
+    uint64_t m_generation = 1;
+    size_t m_hits = 0;
+    size_t m_misses = 0;
+};
+
+}  // namespace executor
+}  // namespace bcos
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "../Common.h"
+#include "KeyLocks.h"
+#include "StorageReadCache.h"
+#include "TableNameInterner.h"
 #include "bcos-framework/interfaces/storage/StorageInterface.h"
 #include "bcos-framework/interfaces/storage/Table.h"
 #include "bcos-framework/libstorage/StateStorage.h"
@@ -61,32 +64,63 @@ public:
     std::optional<storage::Entry> getRow(
         const std::string_view& table, const std::string_view& _key)
     {
-        acquireKeyLock(_key);
+        acquireKeyLock(table, _key);
 
-        GetRowResponse value;
-        m_storage->asyncGetRow(table, _key, [&value](auto&& error, auto&& entry) mutable {
-            value = {std::move(error), std::move(entry)};
-        });
+        return readRow(table, _key);
+    }
 
-        auto& [error, entry] = value;
+    // The rows of interned tables are served by the read cache if it is enabled, the storage is
+    // still addressed by name
+    std::optional<storage::Entry> getRow(const InternedTable& table, const std::string_view& _key)
+    {
+        acquireKeyLock(table.hash, _key);
 
-        if (error)
+        if (m_readCache)
         {
-            BOOST_THROW_EXCEPTION(*error);
+            auto cached = m_readCache->find(table.id, _key);
+            if (cached)
+            {
+                return *cached;
+            }
         }
 
-        return std::move(entry);
+        auto entry = readRow(table.name, _key);
+        if (m_readCache)
+        {
+            m_readCache->insert(table.id, _key, entry);
+        }
+        return entry;
+    }
+
+    void setRow(const InternedTable& table, const std::string_view& key, storage::Entry entry)
+    {
+        acquireKeyLock(table.hash, key);
+
+        if (m_readCache)
+        {
+            m_readCache->insert(table.id, key, entry);
+        }
+        writeRow(table.name, key, std::move(entry));
+    }
+
+    // Read a row written only once when the contract is created, e.g. the code hash, the caller
+    // should hold the key lock of the row written together with it
+    std::optional<storage::Entry> getImmutableRow(
+        const std::string_view& table, const std::string_view& _key)
+    {
+        return readRow(table, _key);
     }
 
     std::vector<std::optional<storage::Entry>> getRows(
         const std::string_view& table, const std::variant<const gsl::span<std::string_view const>,
                                            const gsl::span<std::string const>>& _keys)
     {
+        auto tableHash = hashTableName(table);
         std::visit(
-            [this](auto&& keys) {
+            [this, tableHash](auto&& keys) {
                 for (auto& it : keys)
                 {
-                    acquireKeyLock(it);
+                    acquireKeyLock(tableHash, it);
                 }
             },
             _keys);
@@ -109,23 +143,75 @@ public:
 
     void setRow(const std::string_view& table, const std::string_view& key, storage::Entry entry)
     {
-        acquireKeyLock(key);
+        acquireKeyLock(table, key);
 
-        SetRowResponse value;
+        // The table may also be accessed by its interned id
+        clearReadCache();
+        writeRow(table, key, std::move(entry));
+    }
 
-        m_storage->asyncSetRow(table, key, std::move(entry),
-            [&value](auto&& error) mutable { value = std::tuple{std::move(error)}; });
+    // Read-modify-write of a single field row with one key lock acquisition, returns the previous
+    // row. The new value is written only if isUnchanged(previous) is false, so rewriting the same
+    // value costs no write.
+    template <class IsUnchanged>
+    std::optional<storage::Entry> exchange(const InternedTable& table,
+        const std::string_view& key, const std::string_view& value, IsUnchanged&& isUnchanged)
+    {
+        acquireKeyLock(table.hash, key);
 
-        auto& [error] = value;
+        std::optional<storage::Entry> previous;
+        std::optional<storage::Entry>* cached = nullptr;
+        if (m_readCache && (cached = m_readCache->find(table.id, key)))
+        {
+            previous = *cached;
+        }
+        else
+        {
+            previous = readRow(table.name, key);
+        }
 
-        if (error)
+        if (!isUnchanged(previous))
         {
-            BOOST_THROW_EXCEPTION(*error);
+            storage::Entry entry;
+            entry.importFields({std::string(value)});
+            if (cached)
+            {
+                *cached = entry;
+            }
+            else if (m_readCache)
+            {
+                m_readCache->insert(table.id, key, entry);
+            }
+            writeRow(table.name, key, std::move(entry));
+        }
+        else if (m_readCache && !cached)
+        {
+            m_readCache->insert(table.id, key, previous);
+        }
+
+        return previous;
+    }
+
+    // Cache the rows of interned tables read by the transaction, at most maxRows rows
+    void enableReadCache(size_t maxRows)
+    {
+        m_readCache.emplace(maxRows);
+    }
+
+    // Drop the cached rows, when the transaction is reverted or other transactions may have
+    // written the storage, e.g. after an external call or waiting for a key lock
+    void clearReadCache()
+    {
+        if (m_readCache)
+        {
+            m_readCache->clear();
         }
     }
 
     std::optional<storage::Table> createTable(std::string _tableName, std::string _valueFields)
     {
+        checkWritable(_tableName);
+
         OpenTableResponse value;
 
         m_storage->asyncCreateTable(std::move(_tableName), std::move(_valueFields),
@@ -161,47 +247,108 @@ public:
         return std::move(table);
     }
 
+    // Reads take no key lock and record nothing, writes throw. For the calls which have their own
+    // storage and can't change the state.
+    void setReadOnly(bool readOnly) { m_readOnly = readOnly; }
+    bool readOnly() const { return m_readOnly; }
+
+    // The recoder is set again after every coroutine switch
     void setRecoder(storage::StateStorage::Recoder::Ptr recoder)
     {
+        if (m_readOnly)
+        {
+            return;
+        }
+        m_recoder = recoder;
         m_storage->setRecoder(std::move(recoder));
     }
 
+    // The key locks held by other transactions, in the encoded form of KeyLockSet
     void importExistsKeyLocks(gsl::span<std::string> keyLocks)
     {
         m_existsKeyLocks.clear();
 
         for (auto& it : keyLocks)
         {
-            m_existsKeyLocks.emplace(std::move(it));
+            m_existsKeyLocks.insertEncoded(it);
         }
     }
 
+    // Only the key locks acquired since the last export, the scheduler accumulates the key locks
+    // of a transaction until it finishes
     std::vector<std::string> exportKeyLocks()
     {
         std::vector<std::string> keyLocks;
-        keyLocks.reserve(m_myKeyLocks.size());
-        for (auto& it : m_myKeyLocks)
+        keyLocks.swap(m_newKeyLocks);
+        return keyLocks;
+    }
+
+    // Hold the key lock of a row as reading it, for the rows served by a cache
+    void acquireKeyLock(uint64_t tableHash, const std::string_view& key)
+    {
+        if (m_readOnly || m_myKeyLocks.contains(tableHash, key))
         {
-            keyLocks.emplace_back(std::move(it));
+            return;
         }
 
-        m_myKeyLocks.clear();
+        if (m_existsKeyLocks.contains(tableHash, key))
+        {
+            m_externalAcquireKeyLocks(KeyLockSet::encode(tableHash, key));
+            // The holder of the lock may have written the rows
+            clearReadCache();
+        }
 
-        return keyLocks;
+        m_myKeyLocks.insert(tableHash, key);
+        m_newKeyLocks.emplace_back(KeyLockSet::encode(tableHash, key));
+    }
+
+    void acquireKeyLock(const std::string_view& table, const std::string_view& key)
+    {
+        acquireKeyLock(hashTableName(table), key);
     }
 
 private:
-    void acquireKeyLock(const std::string_view& key)
+    std::optional<storage::Entry> readRow(
+        const std::string_view& table, const std::string_view& _key)
+    {
+        GetRowResponse value;
+        m_storage->asyncGetRow(table, _key, [&value](auto&& error, auto&& entry) mutable {
+            value = {std::move(error), std::move(entry)};
+        });
+
+        auto& [error, entry] = value;
+
+        if (error)
+        {
+            BOOST_THROW_EXCEPTION(*error);
+        }
+
+        return std::move(entry);
+    }
+
+    void checkWritable(const std::string_view& table)
     {
-        if (m_existsKeyLocks.find(key) != m_existsKeyLocks.end())
+        if (m_readOnly)
         {
-            m_externalAcquireKeyLocks(std::string(key));
+            BOOST_THROW_EXCEPTION(BCOS_ERROR(ExecuteError::WRITE_IN_READ_ONLY,
+                "Write table " + std::string(table) + " in read-only mode"));
         }
+    }
+
+    void writeRow(const std::string_view& table, const std::string_view& key, storage::Entry entry)
+    {
+        checkWritable(table);
+
+        SetRowResponse value;
+
+        m_storage->asyncSetRow(table, key, std::move(entry),
+            [&value](auto&& error) mutable { value = std::tuple{std::move(error)}; });
 
-        auto it = m_myKeyLocks.lower_bound(key);
-        if (it == m_myKeyLocks.end() || *it != key)
+        auto& [error] = value;
+
+        if (error)
         {
-            m_myKeyLocks.emplace_hint(it, key);
+            BOOST_THROW_EXCEPTION(*error);
         }
     }
 
@@ -209,7 +356,11 @@ private:
     std::function<void(std::string)> m_externalAcquireKeyLocks;
     bcos::storage::StateStorage::Recoder::Ptr m_recoder;
 
-    std::set<std::string, std::less<>> m_existsKeyLocks;
-    std::set<std::string, std::less<>> m_myKeyLocks;
+    KeyLockSet m_existsKeyLocks;
+    KeyLockSet m_myKeyLocks;                // all the key locks held by the transaction
+    std::vector<std::string> m_newKeyLocks;  // encoded, not exported yet
+
+    std::optional<StorageReadCache<std::optional<storage::Entry>>> m_readCache;
+    bool m_readOnly = false;
 };
 }  // namespace bcos::executor
\ No newline at end of file
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief intern the table names of an executive into compact ids
+ * @file TableNameInterner.h
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace bcos
+{
+namespace executor
+{
+// 64 bits FNV-1a hash of a table name, it is the same in every executor so it can be sent to
+// the scheduler, e.g. in the key locks
+inline uint64_t hashTableName(std::string_view name)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (auto c : name)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// A table name interned by the executive, the name is owned by the interner
+struct InternedTable
+{
+    uint32_t id = 0;
+    std::string_view name;
+    uint64_t hash = 0;  // hashTableName(name)
+};
+
+// Owned by a single executive, like the read cache keyed by the ids, so it isn't thread safe.
+// The ids only key the read cache of SyncStorageWrapper, StateStorage of bcos-framework still
+// addresses the tables by name.
+class TableNameInterner
+{
+public:
+    TableNameInterner() = default;
+    TableNameInterner(const TableNameInterner&) = delete;
+    TableNameInterner& operator=(const TableNameInterner&) = delete;
+
+    // The same name always gets the same id, ids are dense and start from 0. A name already
+    // interned is found without copying it.
+    InternedTable intern(std::string_view name)
+    {
+        auto it = m_ids.find(name);
+        if (it != m_ids.end())
+        {
+            return get(it->second);
+        }
+
+        // The elements of deque never move on push_back, the name viewed by the key is stable
+        auto id = static_cast<uint32_t>(m_names.size());
+        auto& [internedName, hash] =
+            m_names.emplace_back(std::string(name), hashTableName(name));
+        m_ids.emplace(internedName, id);
+        return {id, internedName, hash};
+    }
+
+    std::string_view name(uint32_t id) const { return m_names[id].first; }
+
+    size_t size() const { return m_names.size(); }
+
+private:
+    InternedTable get(uint32_t id) const
+    {
+        auto& [name, hash] = m_names[id];
+        return {id, name, hash};
+    }
+
+    std::unordered_map<std::string_view, uint32_t> m_ids;
+    std::deque<std::pair<std::string, uint64_t>> m_names;
+};
+
+}  // namespace executor
+}  // namespace bcos
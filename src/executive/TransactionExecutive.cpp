@@ -53,9 +53,70 @@ using namespace bcos::precompiled;
 /// Error info for VMInstance status code.
 using errinfo_evmcStatusCode = boost::error_info<struct tag_evmcStatusCode, evmc_status_code>;
 
+namespace
+{
+// Whether the code has an opcode sending a message to another contract, the push data is skipped
+bool hasCallOpcode(bytesConstRef code)
+{
+    for (size_t i = 0; i < code.size(); ++i)
+    {
+        auto opcode = code[i];
+        switch (opcode)
+        {
+        case OP_CREATE:
+        case OP_CALL:
+        case OP_CALLCODE:
+        case OP_DELEGATECALL:
+        case OP_CREATE2:
+        case OP_STATICCALL:
+            return true;
+        default:
+            if (opcode >= OP_PUSH1 && opcode <= OP_PUSH32)
+            {
+                i += opcode - OP_PUSH1 + 1;
+            }
+            break;
+        }
+    }
+    return false;
+}
+}  // namespace
+
 CallParameters::UniquePtr TransactionExecutive::start(CallParameters::UniquePtr input)
 {
-    m_pullMessage.emplace([this, inputPtr = input.release()](Coroutine::push_type& push) {
+    auto blockContext = m_blockContext.lock();
+    if (!blockContext)
+    {
+        BOOST_THROW_EXCEPTION(BCOS_ERROR(-1, "blockContext is null"));
+    }
+
+    // Wasm code isn't scanned for calls, and imported key locks may require a switch at any read,
+    // both are executed in coroutine directly
+    if ((m_lazyCoroutine || m_readOnly) && !blockContext->isWasm() && input->keyLocks.empty())
+    {
+        auto backup = input->clone();
+        try
+        {
+            COROUTINE_TRACE_LOG(TRACE, m_contextID, m_seq) << "Execute without coroutine";
+
+            initStorageWrapper(*blockContext);
+            auto output = execute(std::move(input));
+            output->keyLocks.clear();
+
+            return output;
+        }
+        catch (CoroutineRequired&)
+        {
+            COROUTINE_TRACE_LOG(TRACE, m_contextID, m_seq)
+                << "External call required, restart in coroutine";
+
+            // Thrown by go() before the code runs, only the frame setup is undone and done again
+            revert();
+            input = std::move(backup);
+        }
+    }
+
+    auto coroutine = [this, inputPtr = input.release()](Coroutine::push_type& push) {
         COROUTINE_TRACE_LOG(TRACE, m_contextID, m_seq) << "Create new coroutine";
 
         // Take ownership from input
@@ -68,17 +129,7 @@ CallParameters::UniquePtr TransactionExecutive::start(CallParameters::UniquePtr
             BOOST_THROW_EXCEPTION(BCOS_ERROR(-1, "blockContext is null"));
         }
 
-        m_storageWrapper = std::make_unique<SyncStorageWrapper>(blockContext->storage(),
-            std::bind(&TransactionExecutive::externalAcquireKeyLocks, this, std::placeholders::_1),
-            m_recoder);
-        if (blockContext->lastStorage())
-        {
-            m_lastStorageWrapper = std::make_shared<SyncStorageWrapper>(
-                std::dynamic_pointer_cast<bcos::storage::StateStorage>(blockContext->lastStorage()),
-                std::bind(
-                    &TransactionExecutive::externalAcquireKeyLocks, this, std::placeholders::_1),
-                m_recoder);
-        }
+        initStorageWrapper(*blockContext);
 
         if (!callParameters->keyLocks.empty())
         {
@@ -93,11 +144,46 @@ CallParameters::UniquePtr TransactionExecutive::start(CallParameters::UniquePtr
         push = std::move(*m_pushMessage);
 
         COROUTINE_TRACE_LOG(TRACE, m_contextID, m_seq) << "Finish coroutine executing";
-    });
+    };
+
+    if (m_stackPool)
+    {
+        m_pullMessage.emplace(m_stackPool->allocator(), std::move(coroutine));
+    }
+    else
+    {
+        m_pullMessage.emplace(std::move(coroutine));
+    }
 
     return dispatcher();
 }
 
+void TransactionExecutive::initStorageWrapper(BlockContext& blockContext)
+{
+    // Nothing is recorded in read-only mode
+    if (!m_readOnly && !m_recoder)
+    {
+        m_recoder = blockContext.storage()->newRecoder();
+    }
+
+    m_storageWrapper = std::make_unique<SyncStorageWrapper>(blockContext.storage(),
+        std::bind(&TransactionExecutive::externalAcquireKeyLocks, this, std::placeholders::_1),
+        m_recoder);
+    m_storageWrapper->setReadOnly(m_readOnly);
+    if (m_storageReadCacheRows > 0)
+    {
+        m_storageWrapper->enableReadCache(m_storageReadCacheRows);
+    }
+    if (blockContext.lastStorage())
+    {
+        m_lastStorageWrapper = std::make_shared<SyncStorageWrapper>(
+            std::dynamic_pointer_cast<bcos::storage::StateStorage>(blockContext.lastStorage()),
+            std::bind(&TransactionExecutive::externalAcquireKeyLocks, this, std::placeholders::_1),
+            m_recoder);
+        m_lastStorageWrapper->setReadOnly(m_readOnly);
+    }
+}
+
 CallParameters::UniquePtr TransactionExecutive::dispatcher()
 {
     try
@@ -132,6 +218,15 @@ CallParameters::UniquePtr TransactionExecutive::dispatcher()
 
 CallParameters::UniquePtr TransactionExecutive::externalCall(CallParameters::UniquePtr input)
 {
+    // The address of a new contract is assigned by the scheduler
+    if (m_localCallDepth < m_maxLocalCallDepth && !input->create)
+    {
+        return localCall(std::move(input));
+    }
+
+    // Code with a call opcode is never executed without coroutine
+    assert(m_pushMessage);
+
     input->keyLocks = m_storageWrapper->exportKeyLocks();
 
     spawnAndCall([this, inputPtr = input.release()](
@@ -142,6 +237,8 @@ CallParameters::UniquePtr TransactionExecutive::externalCall(CallParameters::Uni
 
     // After coroutine switch, set the recoder
     m_storageWrapper->setRecoder(m_recoder);
+    // The callee and other transactions may have written the rows
+    m_storageWrapper->clearReadCache();
 
     // Set the keyLocks
     m_storageWrapper->importExistsKeyLocks(output->keyLocks);
@@ -149,9 +246,71 @@ CallParameters::UniquePtr TransactionExecutive::externalCall(CallParameters::Uni
     return output;
 }
 
+CallParameters::UniquePtr TransactionExecutive::localCall(CallParameters::UniquePtr input)
+{
+    COROUTINE_TRACE_LOG(TRACE, m_contextID, m_seq)
+        << "Local call" << LOG_KV("to", input->receiveAddress)
+        << LOG_KV("depth", m_localCallDepth + 1);
+
+    auto blockContext = m_blockContext.lock();
+    if (!blockContext)
+    {
+        BOOST_THROW_EXCEPTION(BCOS_ERROR(-1, "blockContext is null"));
+    }
+
+    // The callee records its changes apart, so reverting it doesn't touch the caller's changes.
+    // Nothing is recorded in read-only mode.
+    auto callerRecoder = std::move(m_recoder);
+    if (!m_readOnly)
+    {
+        m_recoder = blockContext->storage()->newRecoder();
+        m_storageWrapper->setRecoder(m_recoder);
+    }
+    ++m_localCallDepth;
+
+    auto restore = [this, &blockContext, &callerRecoder](bool finished) {
+        if (m_recoder && finished)
+        {
+            // Keep the callee's changes as the caller's, in the order they were made
+            for (auto it = std::make_reverse_iterator(m_recoder->end());
+                 it != std::make_reverse_iterator(m_recoder->begin()); ++it)
+            {
+                callerRecoder->log(bcos::storage::StateStorage::Recoder::Change(
+                    it->table, it->key, it->entry));
+            }
+        }
+        else if (m_recoder)
+        {
+            blockContext->storage()->rollback(*m_recoder);
+        }
+
+        --m_localCallDepth;
+        m_recoder = std::move(callerRecoder);
+        m_storageWrapper->setRecoder(m_recoder);
+        m_storageWrapper->clearReadCache();
+    };
+
+    CallParameters::UniquePtr output;
+    try
+    {
+        output = execute(std::move(input));
+    }
+    catch (...)
+    {
+        restore(false);
+        throw;
+    }
+    restore(output->type == CallParameters::FINISHED);
+
+    return output;
+}
+
 void TransactionExecutive::externalAcquireKeyLocks(std::string acquireKeyLock)
 {
-    EXECUTOR_LOG(TRACE) << "Executor acquire key lock: " << acquireKeyLock;
+    EXECUTOR_LOG(TRACE) << "Executor acquire key lock: " << toHex(acquireKeyLock);
+    // Executed without coroutine only with no imported key locks, or in read-only mode which
+    // takes no key lock, so a wait is never requested there
+    assert(m_pushMessage);
 
     auto callParameters = std::make_unique<CallParameters>(CallParameters::KEY_LOCK);
     callParameters->senderAddress = m_contractAddress;
@@ -249,7 +408,7 @@ TransactionExecutive::callPrecompiled(CallParameters::UniquePtr callParameters)
     try
     {
         auto precompiledResult = execPrecompiled(callParameters->codeAddress,
-            ref(callParameters->data), callParameters->origin, callParameters->senderAddress);
+            callParameters->data.ref(), callParameters->origin, callParameters->senderAddress);
         auto gas = precompiledResult->m_gas;
         if (callParameters->gas < gas)
         {
@@ -265,21 +424,21 @@ TransactionExecutive::callPrecompiled(CallParameters::UniquePtr callParameters)
     {
         const string* _msg = boost::get_error_info<errinfo_comment>(e);
         writeErrInfoToOutput(_msg ? *_msg : "error occurs in precompiled, but error_info is empty",
-            callParameters->data);
+            callParameters->data.mutableBytes());
         revert();
         callParameters->type = CallParameters::REVERT;
         callParameters->status = (int32_t)TransactionStatus::PrecompiledError;
     }
     catch (Exception& e)
     {
-        writeErrInfoToOutput(e.what(), callParameters->data);
+        writeErrInfoToOutput(e.what(), callParameters->data.mutableBytes());
         revert();
         callParameters->type = CallParameters::REVERT;
         callParameters->status = (int32_t)executor::toTransactionStatus(e);
     }
     catch (std::exception& e)
     {
-        writeErrInfoToOutput(e.what(), callParameters->data);
+        writeErrInfoToOutput(e.what(), callParameters->data.mutableBytes());
         revert();
         callParameters->type = CallParameters::REVERT;
         callParameters->status = (int32_t)TransactionStatus::Unknown;
@@ -302,7 +461,7 @@ std::tuple<std::unique_ptr<HostContext>, CallParameters::UniquePtr> TransactionE
 
     if (blockContext->isWasm())
     {
-        auto data = ref(callParameters->data);
+        auto data = callParameters->data.ref();
 
         auto input = std::make_pair(std::make_pair(code, params), abi);
         auto codec = std::make_shared<PrecompiledCodec>(blockContext->hashHandler(), true);
@@ -461,11 +620,8 @@ CallParameters::UniquePtr TransactionExecutive::go(
                 evmcMessage.input_data = hostContext.data().data();
                 evmcMessage.input_size = hostContext.data().size();
 
-                auto myAddressBytes = boost::algorithm::unhex(std::string(hostContext.myAddress()));
-                auto callerBytes = boost::algorithm::unhex(std::string(hostContext.caller()));
-
-                evmcMessage.destination = toEvmC(myAddressBytes);
-                evmcMessage.sender = toEvmC(callerBytes);
+                evmcMessage.destination = hexToEvmC(hostContext.myAddress());
+                evmcMessage.sender = hexToEvmC(hostContext.caller());
             }
 
             return evmcMessage;
@@ -489,6 +645,11 @@ CallParameters::UniquePtr TransactionExecutive::go(
             {
                 vmKind = VMKind::Hera;
             }
+            else if (!m_pushMessage && hasCallOpcode(code))
+            {
+                // Restart in coroutine before executing anything, rather than at the first call
+                throw CoroutineRequired();
+            }
 
             auto vm = VMFactory::create(vmKind);
 
@@ -590,6 +751,11 @@ CallParameters::UniquePtr TransactionExecutive::go(
             {
                 vmKind = VMKind::Hera;
             }
+            else if (!m_pushMessage && hasCallOpcode(code))
+            {
+                // Restart in coroutine before executing anything, rather than at the first call
+                throw CoroutineRequired();
+            }
             auto vm = VMFactory::create(vmKind);
 
             auto mode = toRevision(hostContext.evmSchedule());
@@ -708,6 +874,8 @@ std::shared_ptr<precompiled::PrecompiledExecResult> TransactionExecutive::execPr
         if (p)
         {
             auto execResult = p->call(shared_from_this(), param, origin, sender);
+            // Precompiled may write the tables directly, not through the read cache
+            m_storageWrapper->clearReadCache();
             return execResult;
         }
         else
@@ -733,37 +901,53 @@ std::shared_ptr<precompiled::PrecompiledExecResult> TransactionExecutive::execPr
     }
 }
 
+std::string TransactionExecutive::getContractTableName(const std::string_view& _address) const
+{
+    // The system contracts are deployed at 0x000...0001xxxx
+    static const std::string c_sysAddressPrefix = std::string(35, '0') + "1";
+
+    auto isSys = m_blockContext.lock()->isAuthCheck() && _address.find(c_sysAddressPrefix) == 0;
+    return bcos::getContractTableName(_address, isSys ? "/sys/" : "/apps/");
+}
+
 bool TransactionExecutive::isPrecompiled(const std::string& address) const
 {
-    return m_constantPrecompiled.count(address) > 0;
+    if (m_constantPrecompiled && m_constantPrecompiled->contains(address))
+    {
+        return true;
+    }
+    return !m_userPrecompiled.empty() && m_userPrecompiled.count(address) > 0;
 }
 
 std::shared_ptr<Precompiled> TransactionExecutive::getPrecompiled(const std::string& address) const
 {
-    auto constantPrecompiled = m_constantPrecompiled.find(address);
+    if (m_constantPrecompiled)
+    {
+        auto constantPrecompiled = m_constantPrecompiled->find(address);
+        if (constantPrecompiled)
+        {
+            return *constantPrecompiled;
+        }
+    }
 
-    if (constantPrecompiled != m_constantPrecompiled.end())
+    if (!m_userPrecompiled.empty())
     {
-        return constantPrecompiled->second;
+        auto userPrecompiled = m_userPrecompiled.find(address);
+        if (userPrecompiled != m_userPrecompiled.end())
+        {
+            return userPrecompiled->second;
+        }
     }
     return {};
 }
 
 bool TransactionExecutive::isBuiltInPrecompiled(const std::string& _a) const
 {
-    std::stringstream prefix;
-    prefix << std::setfill('0') << std::setw(36);
-    if (_a.find(prefix.str()) != 0)
-        return false;
     return m_builtInPrecompiled->find(_a) != m_builtInPrecompiled->end();
 }
 
 bool TransactionExecutive::isEthereumPrecompiled(const string& _a) const
 {
-    std::stringstream prefix;
-    prefix << std::setfill('0') << std::setw(39);
-    if (_a.find(prefix.str()) != 0)
-        return false;
     return m_evmPrecompiled->find(_a) != m_evmPrecompiled->end();
 }
 
@@ -786,12 +970,7 @@ void TransactionExecutive::setEVMPrecompiled(
 void TransactionExecutive::setConstantPrecompiled(
     const string& address, std::shared_ptr<precompiled::Precompiled> precompiled)
 {
-    m_constantPrecompiled.insert(std::make_pair(address, precompiled));
-}
-void TransactionExecutive::setConstantPrecompiled(
-    std::map<std::string, std::shared_ptr<precompiled::Precompiled>> _constantPrecompiled)
-{
-    m_constantPrecompiled = std::move(_constantPrecompiled);
+    m_userPrecompiled.insert(std::make_pair(address, precompiled));
 }
 
 void TransactionExecutive::revert()
@@ -804,8 +983,17 @@ void TransactionExecutive::revert()
         BOOST_THROW_EXCEPTION(BCOS_ERROR(-1, "blockContext is null!"));
     }
 
+    if (!m_recoder)
+    {
+        return;
+    }
+
     blockContext->storage()->rollback(*m_recoder);
     m_recoder->clear();
+    if (m_storageWrapper)
+    {
+        m_storageWrapper->clearReadCache();
+    }
 }
 
 CallParameters::UniquePtr TransactionExecutive::parseEVMCResult(
@@ -1112,6 +1300,6 @@ bool TransactionExecutive::checkAuth(
     {
         return contractAuthPrecompiled->checkDeployAuth(shared_from_this(), address);
     }
-    bytesRef func = ref(callParameters->data).getCroppedData(0, 4);
+    auto func = callParameters->data.ref().getCroppedData(0, 4);
     return contractAuthPrecompiled->checkMethodAuth(shared_from_this(), path, func, address);
 }
\ No newline at end of file
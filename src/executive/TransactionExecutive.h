@@ -24,7 +24,10 @@
 #include "../Common.h"
 #include "../precompiled/PrecompiledResult.h"
 #include "BlockContext.h"
+#include "CoroutineStackPool.h"
+#include "PrecompiledRegistry.h"
 #include "SyncStorageWrapper.h"
+#include "TableNameInterner.h"
 #include "bcos-executor/TransactionExecutor.h"
 #include "bcos-framework/interfaces/executor/ExecutionMessage.h"
 #include "bcos-framework/interfaces/protocol/BlockHeader.h"
@@ -57,6 +60,7 @@ struct PrecompiledExecResult;
 namespace executor
 {
 class HostContext;
+class ContractCodeCache;
 
 class TransactionExecutive : public std::enable_shared_from_this<TransactionExecutive>
 {
@@ -92,7 +96,6 @@ public:
         m_seq(seq),
         m_gasInjector(gasInjector)
     {
-        m_recoder = m_blockContext.lock()->storage()->newRecoder();
         m_hashImpl = m_blockContext.lock()->hashHandler();
     }
 
@@ -128,6 +131,16 @@ public:
 
     std::string_view contractAddress() { return m_contractAddress; }
 
+    // The table of the contract, under /sys/ for the system contracts when auth check is enabled
+    std::string getContractTableName(const std::string_view& _address) const;
+
+    // The id of a table for the read cache of the storage, a table already interned by a previous
+    // frame of the executive is found without copying the name
+    InternedTable internTable(const std::string_view& _tableName)
+    {
+        return m_tableNames.intern(_tableName);
+    }
+
     CallParameters::UniquePtr execute(
         CallParameters::UniquePtr callParameters);  // execute parameters in
                                                     // current corouitine
@@ -136,6 +149,7 @@ public:
 
     std::shared_ptr<precompiled::Precompiled> getPrecompiled(const std::string& _address) const;
 
+    // Register a precompiled only visible to this executive, it overlays the shared registry
     void setConstantPrecompiled(
         const std::string& _address, std::shared_ptr<precompiled::Precompiled> precompiled);
 
@@ -144,6 +158,36 @@ public:
         m_builtInPrecompiled = std::move(_builtInPrecompiled);
     }
 
+    // Execute without key locks and change recoders, on the caller's stack as lazy coroutine does,
+    // writes throw
+    void setReadOnly(bool readOnly) { m_readOnly = readOnly; }
+
+    // Execute on the caller's stack if the called code can't call other contracts, otherwise
+    // restart in a coroutine before the code runs
+    void setLazyCoroutine(bool lazyCoroutine) { m_lazyCoroutine = lazyCoroutine; }
+
+    void setCoroutineStackPool(CoroutineStackPool::Ptr stackPool)
+    {
+        m_stackPool = std::move(stackPool);
+    }
+
+    // Share the immutable contract code across calls, nullptr to load the code from storage every
+    // call
+    void setCodeCache(std::shared_ptr<ContractCodeCache> codeCache)
+    {
+        m_codeCache = std::move(codeCache);
+    }
+    const std::shared_ptr<ContractCodeCache>& codeCache() const { return m_codeCache; }
+
+    // Cache the contract storage rows read by the transaction, 0 to read the storage every time
+    void setStorageReadCacheRows(size_t rows) { m_storageReadCacheRows = rows; }
+
+    // Execute up to depth nested calls on this executive, without returning them to the scheduler.
+    // The callee's key locks are reported as the caller's, so it is only for the contexts no other
+    // transaction runs concurrently with, e.g. calls. Each level takes the coroutine stack of a
+    // frame.
+    void setMaxLocalCallDepth(size_t depth) { m_maxLocalCallDepth = depth; }
+
     bool isBuiltInPrecompiled(const std::string& _a) const;
 
     bool isEthereumPrecompiled(const std::string& _a) const;
@@ -156,9 +200,10 @@ public:
         std::shared_ptr<const std::map<std::string, std::shared_ptr<PrecompiledContract>>>
             precompiledContract);
 
-    void setConstantPrecompiled(
-        const std::map<std::string, std::shared_ptr<precompiled::Precompiled>>
-            _constantPrecompiled);
+    void setConstantPrecompiled(PrecompiledRegistry::Ptr _constantPrecompiled)
+    {
+        m_constantPrecompiled = std::move(_constantPrecompiled);
+    }
 
     std::shared_ptr<precompiled::PrecompiledExecResult> execPrecompiled(const std::string& address,
         bytesConstRef param, const std::string& origin, const std::string& sender);
@@ -177,8 +222,17 @@ public:
     }
 
 private:
+    // Thrown by go() before the VM runs code that may switch coroutine while executing without
+    // coroutine, never from inside the VM. It isn't derived from std::exception so the error
+    // handlers on the way don't swallow it
+    struct CoroutineRequired
+    {
+    };
+
     CallParameters::UniquePtr dispatcher();
 
+    void initStorageWrapper(BlockContext& blockContext);
+
     std::tuple<std::unique_ptr<HostContext>, CallParameters::UniquePtr> call(
         CallParameters::UniquePtr callParameters);
     std::tuple<std::unique_ptr<HostContext>, CallParameters::UniquePtr> callPrecompiled(
@@ -190,6 +244,8 @@ private:
 
     void spawnAndCall(std::function<void(ResumeHandler)> function);
 
+    CallParameters::UniquePtr localCall(CallParameters::UniquePtr input);
+
     void revert();
 
     CallParameters::UniquePtr parseEVMCResult(
@@ -202,26 +258,6 @@ private:
         output = std::move(codecOutput);
     }
 
-    inline std::string getContractTableName(const std::string_view& _address)
-    {
-        auto blockContext = m_blockContext.lock();
-        std::string addressLower(_address);
-        boost::algorithm::to_lower(addressLower);
-
-        std::string address = (_address[0] == '/') ? addressLower.substr(1) : addressLower;
-
-        if (blockContext->isAuthCheck())
-        {
-            std::stringstream prefix;
-            prefix << std::setfill('0') << std::setw(36) << 1;
-            if (_address.find(prefix.str()) == 0)
-            {
-                return std::string("/sys/").append(address);
-            }
-        }
-        return std::string("/apps/").append(address);
-    }
-
     bool checkAuth(const CallParameters::UniquePtr& callParameters, bool _isCreate);
 
     void creatAuthTable(
@@ -230,7 +266,8 @@ private:
     bool buildBfsPath(std::string const& _absoluteDir);
 
     std::weak_ptr<BlockContext> m_blockContext;  ///< Information on the runtime environment.
-    std::map<std::string, std::shared_ptr<precompiled::Precompiled>> m_constantPrecompiled;
+    PrecompiledRegistry::Ptr m_constantPrecompiled;
+    std::unordered_map<std::string, std::shared_ptr<precompiled::Precompiled>> m_userPrecompiled;
     std::shared_ptr<const std::map<std::string, std::shared_ptr<PrecompiledContract>>>
         m_evmPrecompiled;
     std::shared_ptr<const std::set<std::string>> m_builtInPrecompiled;
@@ -248,6 +285,14 @@ private:
     CallParameters::UniquePtr m_exchangeMessage = nullptr;
     bool m_finished = false;
 
+    bool m_lazyCoroutine = false;
+    bool m_readOnly = false;
+    CoroutineStackPool::Ptr m_stackPool;
+    std::shared_ptr<ContractCodeCache> m_codeCache;
+    size_t m_storageReadCacheRows = 0;
+    TableNameInterner m_tableNames;
+    size_t m_maxLocalCallDepth = 0;
+    size_t m_localCallDepth = 0;
     std::optional<Coroutine::pull_type> m_pullMessage;
     std::optional<Coroutine::push_type> m_pushMessage;
 };
@@ -0,0 +1,89 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief cache of the results of calls against the last committed block
+ * @file CallResultCache.cpp
+ */
+
+#include "CallResultCache.h"
+#include <boost/functional/hash.hpp>
+
+using namespace bcos;
+using namespace bcos::executor;
+
+CallResultCache::CallResultCache(size_t capacity)
+  : m_capacity(capacity), m_cache(std::max<size_t>(capacity >> c_shardBits, 1), c_shardBits)
+{}
+
+std::string CallResultCache::key(const protocol::ExecutionMessage& input)
+{
+    auto gas = input.gasAvailable();
+    auto data = input.data();
+
+    std::string key;
+    key.reserve(input.to().size() + input.from().size() + input.origin().size() + sizeof(gas) +
+                data.size() + 3);
+    key.append(input.to()).push_back('\0');
+    key.append(input.from()).push_back('\0');
+    key.append(input.origin()).push_back('\0');
+    key.append(reinterpret_cast<const char*>(&gas), sizeof(gas));
+    key.append(reinterpret_cast<const char*>(data.data()), data.size());
+    return key;
+}
+
+size_t CallResultCache::hashOf(protocol::BlockNumber number, const std::string& key)
+{
+    auto hash = std::hash<std::string>{}(key);
+    boost::hash_combine(hash, number);
+    return hash;
+}
+
+bool CallResultCache::get(
+    protocol::BlockNumber number, const std::string& key, protocol::ExecutionMessage& output)
+{
+    auto handle = m_cache.lookup(hashOf(number, key));
+    // The cache only knows the hash of the key, check the whole key before reusing
+    if (handle.isValid() && handle.value().number == number && handle.value().key == key)
+    {
+        auto& result = handle.value();
+        output.setType(result.type);
+        output.setStatus(result.status);
+        output.setMessage(result.message);
+        output.setData(result.data);
+        output.setGasAvailable(result.gasAvailable);
+
+        ++m_hits;
+        return true;
+    }
+
+    ++m_misses;
+    return false;
+}
+
+void CallResultCache::insert(
+    protocol::BlockNumber number, std::string key, const protocol::ExecutionMessage& result)
+{
+    auto hash = hashOf(number, key);
+    auto value = std::make_unique<CallResult>(CallResult{number, std::move(key), result.type(),
+        result.status(), std::string(result.message()), result.data().toBytes(),
+        result.gasAvailable()});
+    auto charge = sizeof(CallResult) + value->key.size() + value->message.size() +
+                  value->data.size();
+    if (m_cache.insert(hash, value.get(), nullptr, charge))
+    {
+        // The cache takes charge of the value once inserted
+        std::ignore = value.release();
+    }
+}
@@ -0,0 +1,93 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief cache of the results of calls against the last committed block
+ * @file CallResultCache.h
+ */
+
+#pragma once
+
+#include "../dag/ClockCache.h"
+#include "bcos-framework/interfaces/executor/ExecutionMessage.h"
+#include "bcos-framework/interfaces/protocol/ProtocolTypeDef.h"
+#include "bcos-framework/libutilities/Common.h"
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace bcos
+{
+namespace executor
+{
+// A call only reads the committed state, its result is the same until the next commit. The
+// results are keyed by the number of the block committed when the call started, flush moves to the
+// next number so the results of the previous blocks are never hit again and are evicted by the new
+// ones.
+class CallResultCache
+{
+public:
+    using Ptr = std::shared_ptr<CallResultCache>;
+
+    // capacity is the bytes of all results in the cache
+    explicit CallResultCache(size_t capacity = 16 * 1024 * 1024);
+
+    CallResultCache(const CallResultCache&) = delete;
+    CallResultCache& operator=(const CallResultCache&) = delete;
+
+    // Called once the committed state of the block is visible to the calls
+    void flush(protocol::BlockNumber number) { m_number.store(number); }
+    protocol::BlockNumber number() const { return m_number.load(); }
+
+    // The fields of a call request the result depends on
+    static std::string key(const protocol::ExecutionMessage& input);
+
+    // Fill the result fields of output if hit, the addresses and the context are left to the caller
+    bool get(
+        protocol::BlockNumber number, const std::string& key, protocol::ExecutionMessage& output);
+
+    void insert(
+        protocol::BlockNumber number, std::string key, const protocol::ExecutionMessage& result);
+
+    size_t capacity() const { return m_capacity; }
+    size_t usage() const { return m_cache.usage(); }
+    uint64_t hits() const { return m_hits.load(); }
+    uint64_t misses() const { return m_misses.load(); }
+
+private:
+    struct CallResult
+    {
+        protocol::BlockNumber number;
+        std::string key;
+        protocol::ExecutionMessage::Type type;
+        int32_t status;
+        std::string message;
+        bytes data;
+        int64_t gasAvailable;
+    };
+
+    static size_t hashOf(protocol::BlockNumber number, const std::string& key);
+
+    static constexpr int c_shardBits = 4;
+
+    size_t m_capacity;
+    std::atomic<protocol::BlockNumber> m_number = 0;
+    ClockCache<size_t, CallResult> m_cache;
+
+    std::atomic<uint64_t> m_hits = 0;
+    std::atomic<uint64_t> m_misses = 0;
+};
+
+}  // namespace executor
+}  // namespace bcos
@@ -26,6 +26,8 @@
 #include "../dag/ScaleUtils.h"
 #include "../dag/TxDAG.h"
 #include "../executive/BlockContext.h"
+#include "../executive/CoroutineStackPool.h"
+#include "../executive/PrecompiledRegistry.h"
 #include "../executive/TransactionExecutive.h"
 #include "../precompiled/CNSPrecompiled.h"
 #include "../precompiled/Common.h"
@@ -40,8 +42,10 @@
 #include "../precompiled/Utilities.h"
 #include "../precompiled/extension/ContractAuthPrecompiled.h"
 #include "../precompiled/extension/DagTransferPrecompiled.h"
+#include "../vm/ContractCodeCache.h"
 #include "../vm/Precompiled.h"
 #include "../vm/gas_meter/GasInjector.h"
+#include "CallResultCache.h"
 #include "bcos-framework/interfaces/dispatcher/SchedulerInterface.h"
 #include "bcos-framework/interfaces/executor/PrecompiledTypeDef.h"
 #include "bcos-framework/interfaces/ledger/LedgerTypeDef.h"
@@ -107,11 +111,44 @@ TransactionExecutor::TransactionExecutor(txpool::TxPoolInterface::Ptr txpool,
 
     initPrecompiled();
     assert(m_precompiledContract);
-    assert(m_constantPrecompiled.size() > 0);
+    assert(m_constantPrecompiled && m_constantPrecompiled->size() > 0);
     assert(m_builtInPrecompiled);
     GlobalHashImpl::g_hashImpl = m_hashImpl;
     m_abiCache = make_shared<ClockCache<bcos::bytes, FunctionAbi>>(32);
     m_gasInjector = std::make_shared<wasm::GasInjector>(wasm::GetInstructionTable());
+    m_coroutineStackPool = std::make_shared<CoroutineStackPool>();
+    m_codeCache = std::make_shared<ContractCodeCache>();
+}
+
+void TransactionExecutor::setCoroutineStackSize(size_t stackSize)
+{
+    // Executives created before keep the previous pool alive through their allocator
+    m_coroutineStackPool = std::make_shared<CoroutineStackPool>(stackSize);
+}
+
+size_t TransactionExecutor::coroutineStackSize() const
+{
+    return m_coroutineStackPool->stackSize();
+}
+
+void TransactionExecutor::setCodeCacheCapacity(size_t capacity)
+{
+    m_codeCache = capacity > 0 ? std::make_shared<ContractCodeCache>(capacity) : nullptr;
+}
+
+size_t TransactionExecutor::codeCacheCapacity() const
+{
+    return m_codeCache ? m_codeCache->capacity() : 0;
+}
+
+void TransactionExecutor::setCallResultCacheCapacity(size_t capacity)
+{
+    m_callResultCache = capacity > 0 ? std::make_shared<CallResultCache>(capacity) : nullptr;
+}
+
+size_t TransactionExecutor::callResultCacheCapacity() const
+{
+    return m_callResultCache ? m_callResultCache->capacity() : 0;
 }
 
 void TransactionExecutor::nextBlockHeader(const bcos::protocol::BlockHeader::ConstPtr& blockHeader,
@@ -122,8 +159,32 @@ void TransactionExecutor::nextBlockHeader(const bcos::protocol::BlockHeader::Con
         EXECUTOR_LOG(INFO) << "NextBlockHeader request: "
                            << LOG_KV("number", blockHeader->number());
 
+        // The first block since started loads the hashes from the ledger, without holding the lock
+        BlockContext::BlockHashes::ConstPtr previousHashes;
+        {
+            std::shared_lock<std::shared_mutex> lock(m_stateStoragesMutex);
+            previousHashes = m_blockHashes;
+        }
+        auto blockHashes = nextBlockHashes(blockHeader, previousHashes);
+
         {
             std::unique_lock<std::shared_mutex> lock(m_stateStoragesMutex);
+            if (m_maxUncommittedCapacity > 0 && !m_stateStorages.empty())
+            {
+                auto capacity = uncommittedCapacityUnlocked();
+                if (capacity >= m_maxUncommittedCapacity)
+                {
+                    auto fmt = boost::format(
+                                   "Uncommitted state capacity exceeded, wait for commit! "
+                                   "capacity: %d, max: %d, blocks: %d") %
+                               capacity % m_maxUncommittedCapacity % m_stateStorages.size();
+                    EXECUTOR_LOG(WARNING) << fmt;
+                    callback(
+                        BCOS_ERROR_UNIQUE_PTR(ExecuteError::STATE_CAPACITY_EXCEEDED, fmt.str()));
+                    return;
+                }
+            }
+
             bcos::storage::StateStorage::Ptr stateStorage;
             bcos::storage::StorageInterface::Ptr lastStateStorage;
             if (m_stateStorages.empty())
@@ -152,13 +213,28 @@ void TransactionExecutor::nextBlockHeader(const bcos::protocol::BlockHeader::Con
                     return;
                 }
 
-                prev.storage->setReadOnly(true);
                 lastStateStorage = prev.storage;
                 stateStorage = std::make_shared<bcos::storage::StateStorage>(prev.storage);
             }
+
+            // Another block came in between, extend its ring instead, from memory only
+            if (m_blockHashes && m_blockHashes != previousHashes)
+            {
+                blockHashes = nextBlockHashes(blockHeader, m_blockHashes);
+            }
+
             // set last commit state storage to blockContext, to auth read last block state
-            m_blockContext = createBlockContext(blockHeader, stateStorage, lastStateStorage);
+            auto blockContext = createBlockContext(blockHeader, stateStorage, lastStateStorage);
+            blockContext->setBlockHashes(blockHashes);
+
+            // Nothing is changed until the new block is ready
+            if (!m_stateStorages.empty())
+            {
+                m_stateStorages.back().storage->setReadOnly(true);
+            }
             m_stateStorages.emplace_back(blockHeader->number(), stateStorage);
+            m_blockContext = std::move(blockContext);
+            m_blockHashes = std::move(blockHashes);
         }
 
         EXECUTOR_LOG(INFO) << "NextBlockHeader success";
@@ -241,7 +317,7 @@ void TransactionExecutor::dagExecuteTransactions(
                 for (size_t i = 0; i < transactions->size(); ++i)
                 {
                     callParametersList->at(indexes[i]) =
-                        createCallParameters(*fillInputs->at(i), *transactions->at(i));
+                        createCallParameters(*fillInputs->at(i), transactions->at(i));
                 }
 
                 if (m_isWasm)
@@ -336,6 +412,7 @@ void TransactionExecutor::dagExecuteTransactionsForEvm(gsl::span<CallParameters:
             try
             {
                 auto output = executive->start(std::move(callParameters));
+                releaseFinishedExecutive(*m_blockContext, *executive, *output);
 
                 executionResults[index] = toExecutionResult(*executive, std::move(output));
             }
@@ -410,7 +487,7 @@ void TransactionExecutor::dagExecuteTransactionsForWasm(
                     continue;
                 }
 
-                auto selector = ref(input).getCroppedData(0, 4);
+                auto selector = input.ref().getCroppedData(0, 4);
                 auto abiKey = bytes(to.cbegin(), to.cend());
                 abiKey.insert(abiKey.end(), selector.begin(), selector.end());
 
@@ -530,6 +607,7 @@ void TransactionExecutor::dagExecuteTransactionsForWasm(
             try
             {
                 auto output = executive->start(std::move(inputs[i]));
+                releaseFinishedExecutive(*m_blockContext, *executive, *output);
                 executionResults[i] = toExecutionResult(*executive, std::move(output));
             }
             catch (std::exception& e)
@@ -627,10 +705,37 @@ void TransactionExecutor::call(bcos::protocol::ExecutionMessage::UniquePtr input
                         << LOG_KV("To", input->to()) << LOG_KV("Create", input->create());
 
     BlockContext::Ptr blockContext;
+    // Only the calls answered without another message are cached
+    auto callResultCache = m_callResultCache;
+    std::optional<std::string> cacheKey;
+    bcos::protocol::BlockNumber cacheNumber = 0;
     switch (input->type())
     {
     case protocol::ExecutionMessage::MESSAGE:
     {
+        if (callResultCache && !input->create())
+        {
+            cacheKey = CallResultCache::key(*input);
+            cacheNumber = callResultCache->number();
+
+            auto result = m_executionMessageFactory->createExecutionMessage();
+            if (callResultCache->get(cacheNumber, *cacheKey, *result))
+            {
+                // Response message, Swap the from and to
+                result->setFrom(std::string(input->to()));
+                result->setTo(std::string(input->from()));
+                result->setContextID(input->contextID());
+                result->setSeq(input->seq());
+                result->setOrigin(std::string(input->origin()));
+                result->setStaticCall(true);
+                result->setCreate(false);
+
+                EXECUTOR_LOG(DEBUG) << "Call success, from call result cache";
+                callback(nullptr, std::move(result));
+                return;
+            }
+        }
+
         bcos::protocol::BlockNumber number = m_lastCommittedBlockNumber;
         storage::StorageInterface::Ptr prev;
 
@@ -649,6 +754,10 @@ void TransactionExecutor::call(bcos::protocol::ExecutionMessage::UniquePtr input
         // Create a temp block context
         blockContext = createBlockContext(
             number, h256(), 0, 0, std::move(storage));  // TODO: complete the block info
+        {
+            std::shared_lock<std::shared_mutex> lock(m_stateStoragesMutex);
+            blockContext->setBlockHashes(m_blockHashes);
+        }
         auto inserted = m_calledContext.emplace(
             std::tuple{input->contextID(), input->seq()}, CallState{blockContext});
 
@@ -697,8 +806,9 @@ void TransactionExecutor::call(bcos::protocol::ExecutionMessage::UniquePtr input
     }
 
     asyncExecute(std::move(blockContext), std::move(input), true,
-        [this, callback = std::move(callback)](
-            Error::UniquePtr&& error, bcos::protocol::ExecutionMessage::UniquePtr&& result) {
+        [this, callback = std::move(callback), callResultCache = std::move(callResultCache),
+            cacheKey = std::move(cacheKey), cacheNumber](
+            Error::UniquePtr&& error, bcos::protocol::ExecutionMessage::UniquePtr&& result) mutable {
             if (error)
             {
                 std::string errorMessage = "Call failed: " + boost::diagnostic_information(*error);
@@ -723,6 +833,11 @@ void TransactionExecutor::call(bcos::protocol::ExecutionMessage::UniquePtr input
                     callback(BCOS_ERROR_UNIQUE_PTR(ExecuteError::CALL_ERROR, message), nullptr);
                     return;
                 }
+
+                if (cacheKey && callResultCache && result->logEntries().empty())
+                {
+                    callResultCache->insert(cacheNumber, std::move(*cacheKey), *result);
+                }
             }
 
             EXECUTOR_LOG(DEBUG) << "Call success";
@@ -892,6 +1007,16 @@ void TransactionExecutor::commit(
             m_lastCommittedBlockNumber = blockNumber;
 
             removeCommittedState();
+            if (m_callResultCache)
+            {
+                m_callResultCache->flush(blockNumber);
+            }
+
+            {
+                std::shared_lock<std::shared_mutex> lock(m_stateStoragesMutex);
+                reportCapacityMetric(uncommittedCapacityUnlocked(), m_stateStorages.size());
+            }
+            reportCacheMetric();
 
             callback(nullptr);
         });
@@ -1042,7 +1167,7 @@ void TransactionExecutor::asyncExecute(std::shared_ptr<BlockContext> blockContex
 
                 auto contextID = input->contextID();
                 auto seq = input->seq();
-                auto callParameters = createCallParameters(*input, *tx);
+                auto callParameters = createCallParameters(*input, tx);
 
                 auto executive =
                     createExecutive(blockContext, callParameters->codeAddress, contextID, seq);
@@ -1051,6 +1176,7 @@ void TransactionExecutor::asyncExecute(std::shared_ptr<BlockContext> blockContex
                 try
                 {
                     auto output = executive->start(std::move(callParameters));
+                    releaseFinishedExecutive(*blockContext, *executive, *output);
 
                     auto message = toExecutionResult(*executive, std::move(output));
                     callback(nullptr, std::move(message));
@@ -1082,6 +1208,7 @@ void TransactionExecutor::asyncExecute(std::shared_ptr<BlockContext> blockContex
             EXECUTOR_LOG(TRACE) << "Entering responseFunc";
             executive->setExchangeMessage(std::move(callParameters));
             auto output = executive->resume();
+            releaseFinishedExecutive(*blockContext, *executive, *output);
             auto message = toExecutionResult(*executive, std::move(output));
 
             callback(nullptr, std::move(message));
@@ -1089,16 +1216,34 @@ void TransactionExecutor::asyncExecute(std::shared_ptr<BlockContext> blockContex
 
             EXECUTOR_LOG(TRACE) << "Exiting responseFunc";
         }
+        else if (input->type() != bcos::protocol::ExecutionMessage::MESSAGE)
+        {
+            // The executive finished or reverted already and was erased, a late response must not
+            // start it again
+            EXECUTOR_LOG(ERROR) << "Response not found executive, contextID: " << contextID
+                                << " seq: " << seq << " type: " << input->type();
+            callback(
+                BCOS_ERROR_UNIQUE_PTR(ExecuteError::EXECUTE_ERROR, "Response not found executive"),
+                nullptr);
+            return;
+        }
         else
         {
             // new external call MESSAGE
             auto executive =
                 createExecutive(blockContext, callParameters->codeAddress, contextID, seq);
+            if (staticCall)
+            {
+                // A call has its own storage, no other transaction could take its key locks
+                executive->setMaxLocalCallDepth(m_maxLocalCallDepth);
+                executive->setReadOnly(true);
+            }
             blockContext->insertExecutive(contextID, seq, {executive});
 
             try
             {
                 auto output = executive->start(std::move(callParameters));
+                releaseFinishedExecutive(*blockContext, *executive, *output);
 
                 auto message = toExecutionResult(*executive, std::move(output));
                 callback(nullptr, std::move(message));
@@ -1127,6 +1272,7 @@ void TransactionExecutor::asyncExecute(std::shared_ptr<BlockContext> blockContex
 
             executive->setExchangeMessage(std::move(callParameters));
             auto output = executive->resume();
+            releaseFinishedExecutive(*blockContext, *executive, *output);
 
             auto message = toExecutionResult(*executive, std::move(output));
 
@@ -1155,6 +1301,17 @@ void TransactionExecutor::asyncExecute(std::shared_ptr<BlockContext> blockContex
     }
 }
 
+void TransactionExecutor::releaseFinishedExecutive(BlockContext& blockContext,
+    const TransactionExecutive& executive, const CallParameters& output)
+{
+    // A FINISHED or REVERT output means the coroutine has returned and no response will be routed
+    // back to this executive, the caller still holds a reference until the result is converted
+    if (output.type == CallParameters::FINISHED || output.type == CallParameters::REVERT)
+    {
+        blockContext.eraseExecutive(executive.contextID(), executive.seq());
+    }
+}
+
 optional<ConflictFields> TransactionExecutor::decodeConflictFields(
     const FunctionAbi& functionAbi, const CallParameters& params)
 {
@@ -1260,7 +1417,7 @@ optional<ConflictFields> TransactionExecutor::decodeConflictFields(
             assert(!conflictField.accessPath.empty());
             const ParameterAbi* paramAbi = nullptr;
             auto components = &functionAbi.inputs;
-            auto inputData = ref(params.data).getCroppedData(4).toBytes();
+            auto inputData = params.data.ref().getCroppedData(4).toBytes();
 
             auto startPos = 0u;
             for (auto segment : conflictField.accessPath)
@@ -1335,6 +1492,7 @@ std::unique_ptr<ExecutionMessage> TransactionExecutor::toExecutionResult(
 std::unique_ptr<protocol::ExecutionMessage> TransactionExecutor::toExecutionResult(
     std::unique_ptr<CallParameters> params)
 {
+    // Not pooled: the message goes to the scheduler as a plain unique_ptr and is deleted there
     auto message = m_executionMessageFactory->createExecutionMessage();
     switch (params->type)
     {
@@ -1363,6 +1521,8 @@ std::unique_ptr<protocol::ExecutionMessage> TransactionExecutor::toExecutionResu
         message->setFrom(std::move(params->receiveAddress));
         message->setTo(std::move(params->senderAddress));
         message->setType(ExecutionMessage::REVERT);
+        // The events of a reverted frame never happened
+        params->logEntries.clear();
         break;
     }
 
@@ -1370,7 +1530,7 @@ std::unique_ptr<protocol::ExecutionMessage> TransactionExecutor::toExecutionResu
     message->setSeq(params->seq);
     message->setOrigin(std::move(params->origin));
     message->setGasAvailable(params->gas);
-    message->setData(std::move(params->data));
+    message->setData(params->data.takeBytes());
     message->setStaticCall(params->staticCall);
     message->setCreate(params->create);
     if (params->createSalt)
@@ -1406,6 +1566,75 @@ std::shared_ptr<BlockContext> TransactionExecutor::createBlockContext(
     return context;
 }
 
+BlockContext::BlockHashes::ConstPtr TransactionExecutor::nextBlockHashes(
+    const protocol::BlockHeader::ConstPtr& blockHeader,
+    const BlockContext::BlockHashes::ConstPtr& previous)
+{
+    // The contexts of the uncommitted blocks still read the previous rings, copy rather than modify
+    auto blockHashes = previous ? std::make_shared<BlockContext::BlockHashes>(*previous) :
+                                  std::make_shared<BlockContext::BlockHashes>();
+    for (const auto& parent : blockHeader->parentInfo())
+    {
+        blockHashes->insert(parent.blockNumber, parent.blockHash);
+    }
+
+    if (previous)
+    {
+        return blockHashes;
+    }
+
+    // First block since started, load the hashes the parents don't cover with one read
+    auto number = blockHeader->number();
+    std::vector<protocol::BlockNumber> numbers;
+    std::vector<std::string> keys;
+    for (auto i = std::max(number - static_cast<protocol::BlockNumber>(blockHashes->size()),
+             (protocol::BlockNumber)0);
+         i < number; ++i)
+    {
+        if (!blockHashes->contains(i))
+        {
+            numbers.push_back(i);
+            keys.push_back(boost::lexical_cast<std::string>(i));
+        }
+    }
+
+    storage::StorageInterface::Ptr ledgerStorage = m_cachedStorage;
+    if (!ledgerStorage)
+    {
+        ledgerStorage = m_backendStorage;
+    }
+    if (keys.empty() || !ledgerStorage)
+    {
+        return blockHashes;
+    }
+
+    std::promise<std::tuple<Error::UniquePtr, std::vector<std::optional<storage::Entry>>>> promise;
+    ledgerStorage->asyncGetRows(ledger::SYS_NUMBER_2_HASH, gsl::span<std::string const>(keys),
+        [&promise](Error::UniquePtr error, std::vector<std::optional<storage::Entry>> entries) {
+            promise.set_value({std::move(error), std::move(entries)});
+        });
+    auto [error, entries] = promise.get_future().get();
+    if (error)
+    {
+        BOOST_THROW_EXCEPTION(*error);
+    }
+
+    size_t loaded = 0;
+    for (size_t i = 0; i < entries.size() && i < numbers.size(); ++i)
+    {
+        if (entries[i])
+        {
+            blockHashes->insert(
+                numbers[i], h256(std::string(entries[i]->getField(0)), h256::FromBinary));
+            ++loaded;
+        }
+    }
+    EXECUTOR_LOG(INFO) << "Load block hashes" << LOG_KV("number", number)
+                       << LOG_KV("request", keys.size()) << LOG_KV("loaded", loaded);
+
+    return blockHashes;
+}
+
 TransactionExecutive::Ptr TransactionExecutor::createExecutive(
     const std::shared_ptr<BlockContext>& _blockContext, const std::string& _contractAddress,
     int64_t contextID, int64_t seq)
@@ -1415,6 +1644,10 @@ TransactionExecutive::Ptr TransactionExecutor::createExecutive(
     executive->setConstantPrecompiled(m_constantPrecompiled);
     executive->setEVMPrecompiled(m_precompiledContract);
     executive->setBuiltInPrecompiled(m_builtInPrecompiled);
+    executive->setCoroutineStackPool(m_coroutineStackPool);
+    executive->setLazyCoroutine(m_lazyCoroutine);
+    executive->setCodeCache(m_codeCache);
+    executive->setStorageReadCacheRows(m_storageReadCacheRows);
 
     // TODO: register User developed Precompiled contract
     // registerUserPrecompiled(context);
@@ -1467,22 +1700,23 @@ void TransactionExecutor::initPrecompiled()
     auto kvTableFactoryPrecompiled =
         std::make_shared<precompiled::KVTableFactoryPrecompiled>(m_hashImpl);
 
+    PrecompiledRegistry::PrecompiledMap constantPrecompiled;
     if (m_isWasm)
     {
-        m_constantPrecompiled.insert({SYS_CONFIG_NAME, sysConfig});
-        m_constantPrecompiled.insert({CONSENSUS_NAME, consensusPrecompiled});
-        m_constantPrecompiled.insert({CNS_NAME, cnsPrecompiled});
-        m_constantPrecompiled.insert({PARALLEL_CONFIG_NAME, parallelConfigPrecompiled});
+        constantPrecompiled.insert({SYS_CONFIG_NAME, sysConfig});
+        constantPrecompiled.insert({CONSENSUS_NAME, consensusPrecompiled});
+        constantPrecompiled.insert({CNS_NAME, cnsPrecompiled});
+        constantPrecompiled.insert({PARALLEL_CONFIG_NAME, parallelConfigPrecompiled});
         // FIXME: not support crud now
         // m_constantPrecompiled.insert({TABLE_NAME, tableFactoryPrecompiled});
-        m_constantPrecompiled.insert({KV_TABLE_NAME, kvTableFactoryPrecompiled});
-        m_constantPrecompiled.insert(
+        constantPrecompiled.insert({KV_TABLE_NAME, kvTableFactoryPrecompiled});
+        constantPrecompiled.insert(
             {DAG_TRANSFER_NAME, std::make_shared<precompiled::DagTransferPrecompiled>(m_hashImpl)});
-        m_constantPrecompiled.insert(
+        constantPrecompiled.insert(
             {CRYPTO_NAME, std::make_shared<CryptoPrecompiled>(m_hashImpl)});
-        m_constantPrecompiled.insert(
+        constantPrecompiled.insert(
             {BFS_NAME, std::make_shared<precompiled::FileSystemPrecompiled>(m_hashImpl)});
-        m_constantPrecompiled.insert({CONTRACT_AUTH_NAME,
+        constantPrecompiled.insert({CONTRACT_AUTH_NAME,
             std::make_shared<precompiled::ContractAuthPrecompiled>(m_hashImpl)});
 
         set<string> builtIn = {CRYPTO_NAME};
@@ -1490,24 +1724,78 @@ void TransactionExecutor::initPrecompiled()
     }
     else
     {
-        m_constantPrecompiled.insert({SYS_CONFIG_ADDRESS, sysConfig});
-        m_constantPrecompiled.insert({CONSENSUS_ADDRESS, consensusPrecompiled});
-        m_constantPrecompiled.insert({CNS_ADDRESS, cnsPrecompiled});
-        m_constantPrecompiled.insert({PARALLEL_CONFIG_ADDRESS, parallelConfigPrecompiled});
+        constantPrecompiled.insert({SYS_CONFIG_ADDRESS, sysConfig});
+        constantPrecompiled.insert({CONSENSUS_ADDRESS, consensusPrecompiled});
+        constantPrecompiled.insert({CNS_ADDRESS, cnsPrecompiled});
+        constantPrecompiled.insert({PARALLEL_CONFIG_ADDRESS, parallelConfigPrecompiled});
         // FIXME: not support crud now
         // m_constantPrecompiled.insert({TABLE_ADDRESS, tableFactoryPrecompiled});
-        m_constantPrecompiled.insert({KV_TABLE_ADDRESS, kvTableFactoryPrecompiled});
-        m_constantPrecompiled.insert({DAG_TRANSFER_ADDRESS,
+        constantPrecompiled.insert({KV_TABLE_ADDRESS, kvTableFactoryPrecompiled});
+        constantPrecompiled.insert({DAG_TRANSFER_ADDRESS,
             std::make_shared<precompiled::DagTransferPrecompiled>(m_hashImpl)});
-        m_constantPrecompiled.insert(
+        constantPrecompiled.insert(
             {CRYPTO_ADDRESS, std::make_shared<CryptoPrecompiled>(m_hashImpl)});
-        m_constantPrecompiled.insert(
+        constantPrecompiled.insert(
             {BFS_ADDRESS, std::make_shared<precompiled::FileSystemPrecompiled>(m_hashImpl)});
-        m_constantPrecompiled.insert({CONTRACT_AUTH_ADDRESS,
+        constantPrecompiled.insert({CONTRACT_AUTH_ADDRESS,
             std::make_shared<precompiled::ContractAuthPrecompiled>(m_hashImpl)});
         set<string> builtIn = {CRYPTO_ADDRESS};
         m_builtInPrecompiled = make_shared<set<string>>(builtIn);
     }
+    m_constantPrecompiled =
+        std::make_shared<const PrecompiledRegistry>(std::move(constantPrecompiled));
+}
+
+size_t TransactionExecutor::uncommittedCapacity()
+{
+    std::shared_lock<std::shared_mutex> lock(m_stateStoragesMutex);
+    return uncommittedCapacityUnlocked();
+}
+
+size_t TransactionExecutor::uncommittedBlocks()
+{
+    std::shared_lock<std::shared_mutex> lock(m_stateStoragesMutex);
+    return m_stateStorages.size();
+}
+
+size_t TransactionExecutor::uncommittedCapacityUnlocked() const
+{
+    size_t capacity = 0;
+    for (auto& state : m_stateStorages)
+    {
+        capacity += state.storage->capacity();
+    }
+    return capacity;
+}
+
+void TransactionExecutor::reportCapacityMetric(size_t capacity, size_t states)
+{
+    EXECUTOR_LOG(INFO) << LOG_BADGE("Metric") << LOG_DESC("uncommitted state capacity")
+                       << LOG_KV("capacity", capacity)
+                       << LOG_KV("maxCapacity", m_maxUncommittedCapacity)
+                       << LOG_KV("states", states)
+                       << LOG_KV("executives", m_blockContext ? m_blockContext->executivesSize() : 0)
+                       << LOG_KV("calledContexts", m_calledContext.size());
+}
+
+void TransactionExecutor::reportCacheMetric()
+{
+    if (m_codeCache)
+    {
+        EXECUTOR_LOG(INFO) << LOG_BADGE("Metric") << LOG_DESC("code cache")
+                           << LOG_KV("hits", m_codeCache->hits())
+                           << LOG_KV("misses", m_codeCache->misses())
+                           << LOG_KV("usage", m_codeCache->usage())
+                           << LOG_KV("capacity", m_codeCache->capacity());
+    }
+    if (m_callResultCache)
+    {
+        EXECUTOR_LOG(INFO) << LOG_BADGE("Metric") << LOG_DESC("call result cache")
+                           << LOG_KV("hits", m_callResultCache->hits())
+                           << LOG_KV("misses", m_callResultCache->misses())
+                           << LOG_KV("usage", m_callResultCache->usage())
+                           << LOG_KV("capacity", m_callResultCache->capacity());
+    }
 }
 
 void TransactionExecutor::removeCommittedState()
@@ -1616,20 +1904,22 @@ std::unique_ptr<CallParameters> TransactionExecutor::createCallParameters(
 }
 
 std::unique_ptr<CallParameters> TransactionExecutor::createCallParameters(
-    bcos::protocol::ExecutionMessage& input, const bcos::protocol::Transaction& tx)
+    bcos::protocol::ExecutionMessage& input, bcos::protocol::Transaction::ConstPtr tx)
 {
     auto callParameters = std::make_unique<CallParameters>(CallParameters::MESSAGE);
 
     callParameters->contextID = input.contextID();
     callParameters->seq = input.seq();
-    callParameters->origin = toHex(tx.sender());
+    callParameters->origin = toHex(tx->sender());
     callParameters->senderAddress = callParameters->origin;
     callParameters->receiveAddress = input.to();
     callParameters->codeAddress = input.to();
     callParameters->gas = input.gasAvailable();
     callParameters->staticCall = input.staticCall();
     callParameters->create = input.create();
-    callParameters->data = tx.input().toBytes();
+    // The transaction is immutable, share its input instead of copying it
+    auto txInput = tx->input();
+    callParameters->data = CallData(std::move(tx), txInput);
     callParameters->keyLocks = input.takeKeyLocks();
 
     return callParameters;
@@ -1643,15 +1933,14 @@ std::vector<std::string> TransactionExecutor::getTxCriticals(const CallParameter
         return {};
     }
 
-    // temp executive
-    auto executive = createExecutive(m_blockContext, std::string(params.receiveAddress), 0, 0);
-    auto p = executive->getPrecompiled(params.receiveAddress);
-    if (p)
+    auto constantPrecompiled = m_constantPrecompiled->find(params.receiveAddress);
+    if (constantPrecompiled)
     {
+        auto& p = *constantPrecompiled;
         // Precompile transaction
         if (p->isParallelPrecompiled())
         {
-            auto ret = vector<string>(p->getParallelTag(ref(params.data), m_isWasm));
+            auto ret = vector<string>(p->getParallelTag(params.data.ref(), m_isWasm));
             for (string& critical : ret)
             {
                 critical += params.receiveAddress;
@@ -1660,7 +1949,10 @@ std::vector<std::string> TransactionExecutor::getTxCriticals(const CallParameter
         }
         return {};
     }
-    uint32_t selector = precompiled::getParamFunc(ref(params.data));
+    uint32_t selector = precompiled::getParamFunc(params.data.ref());
+
+    // temp executive
+    auto executive = createExecutive(m_blockContext, std::string(params.receiveAddress), 0, 0);
 
     auto receiveAddress = params.receiveAddress;
     std::shared_ptr<precompiled::ParallelConfig> config = nullptr;
@@ -1709,7 +2001,7 @@ std::vector<std::string> TransactionExecutor::getTxCriticals(const CallParameter
     paramTypes.resize((size_t)config->criticalSize);
 
     codec::abi::ContractABICodec abi(m_hashImpl);
-    isOk = abi.abiOutByFuncSelector(ref(params.data).getCroppedData(4), paramTypes, res);
+    isOk = abi.abiOutByFuncSelector(params.data.ref().getCroppedData(4), paramTypes, res);
     if (!isOk)
     {
         EXECUTOR_LOG(DEBUG) << LOG_DESC("[getTxCriticals] abiout failed, ")
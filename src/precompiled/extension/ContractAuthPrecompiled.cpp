@@ -350,7 +350,7 @@ bool ContractAuthPrecompiled::checkMethodAuth(
 
 bool ContractAuthPrecompiled::checkMethodAuth(
     const std::shared_ptr<executor::TransactionExecutive>& _executive, const std::string& _path,
-    bytesRef func, const Address& account)
+    bytesConstRef func, const Address& account)
 {
     auto path = _path;
     path = getAuthTableName(path);
@@ -46,7 +46,7 @@ public:
         const std::string& _origin, const std::string& _sender) override;
 
     bool checkMethodAuth(const std::shared_ptr<executor::TransactionExecutive>& _executive,
-        const std::string& path, bytesRef func, const Address& account);
+        const std::string& path, bytesConstRef func, const Address& account);
 
     bool checkDeployAuth(
         const std::shared_ptr<executor::TransactionExecutive>& _executive, const Address& account);
@@ -0,0 +1,55 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief cache of immutable contract code keyed by code hash, shared by all executives
+ * @file ContractCodeCache.cpp
+ */
+
+#include "ContractCodeCache.h"
+#include <boost/functional/hash.hpp>
+
+using namespace bcos;
+using namespace bcos::executor;
+
+ContractCodeCache::ContractCodeCache(size_t capacity)
+  : m_capacity(capacity), m_cache(std::max<size_t>(capacity >> c_shardBits, 1), c_shardBits)
+{}
+
+ContractCodeCache::Code ContractCodeCache::get(const h256& codeHash)
+{
+    auto key = boost::hash_range(codeHash.data(), codeHash.data() + h256::size);
+    auto handle = m_cache.lookup(key);
+    // The cache only knows the hash of the key, check the whole key before reusing
+    if (handle.isValid() && handle.value().codeHash == codeHash)
+    {
+        ++m_hits;
+        return handle.value().code;
+    }
+
+    ++m_misses;
+    return nullptr;
+}
+
+void ContractCodeCache::insert(const h256& codeHash, Code code)
+{
+    auto key = boost::hash_range(codeHash.data(), codeHash.data() + h256::size);
+    auto charge = sizeof(CachedCode) + code->size();
+    auto value = std::make_unique<CachedCode>(CachedCode{codeHash, std::move(code)});
+    if (m_cache.insert(key, value.get(), nullptr, charge))
+    {
+        // The cache takes charge of the value once inserted
+        std::ignore = value.release();
+    }
+}
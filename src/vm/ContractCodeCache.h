@@ -0,0 +1,72 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief cache of immutable contract code keyed by code hash, shared by all executives
+ * @file ContractCodeCache.h
+ */
+
+#pragma once
+
+#include "../dag/ClockCache.h"
+#include "bcos-framework/libutilities/Common.h"
+#include "bcos-framework/libutilities/FixedBytes.h"
+#include <atomic>
+#include <memory>
+
+namespace bcos
+{
+namespace executor
+{
+class ContractCodeCache
+{
+public:
+    using Ptr = std::shared_ptr<ContractCodeCache>;
+    using Code = std::shared_ptr<const bytes>;
+
+    // capacity is the bytes of all code in the cache
+    explicit ContractCodeCache(size_t capacity = 256 * 1024 * 1024);
+
+    ContractCodeCache(const ContractCodeCache&) = delete;
+    ContractCodeCache& operator=(const ContractCodeCache&) = delete;
+
+    // Return nullptr if missed, the code stays valid after being evicted
+    Code get(const h256& codeHash);
+
+    // The code is immutable once deployed, different code always has different hash
+    void insert(const h256& codeHash, Code code);
+
+    size_t capacity() const { return m_capacity; }
+    size_t usage() const { return m_cache.usage(); }
+    uint64_t hits() const { return m_hits.load(); }
+    uint64_t misses() const { return m_misses.load(); }
+
+private:
+    struct CachedCode
+    {
+        h256 codeHash;
+        Code code;
+    };
+
+    static constexpr int c_shardBits = 4;
+
+    size_t m_capacity;
+    ClockCache<size_t, CachedCode> m_cache;
+
+    std::atomic<uint64_t> m_hits = 0;
+    std::atomic<uint64_t> m_misses = 0;
+};
+
+}  // namespace executor
+}  // namespace bcos
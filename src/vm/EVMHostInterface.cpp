@@ -72,7 +72,8 @@ evmc_storage_status setStorage(evmc_host_context* _context, const evmc_address*
 
     u256 index = fromEvmC(*_key);
     u256 value = fromEvmC(*_value);
-    u256 oldValue = hostContext.store(index);
+    // Read the old value and write the new one with a single key lock acquisition
+    u256 oldValue = hostContext.exchangeStore(index, value);
 
     if (value == oldValue)
         return EVMC_STORAGE_UNCHANGED;
@@ -85,7 +86,6 @@ evmc_storage_status setStorage(evmc_host_context* _context, const evmc_address*
         status = EVMC_STORAGE_DELETED;
         hostContext.sub().refunds += hostContext.evmSchedule().sstoreRefundGas;
     }
-    hostContext.setStore(index, value);  // Interface uses native endianness
     return status;
 }
 
@@ -100,26 +100,26 @@ evmc_bytes32 getBalance(evmc_host_context* _context, const evmc_address* _addr)
     return toEvmC(h256(0));
 }
 
-size_t getCodeSize(evmc_host_context* _context, const evmc_address* _addr)
+std::string toHexAddress(const evmc_address& _addr)
 {
-    //   auto &hostContext = static_cast<HostContext &>(*_context);
-    //   return hostContext.codeSizeAt(fromEvmC(*_addr));
+    auto addressBytes = fromEvmC(_addr);
+    std::string address;
+    address.reserve(addressBytes.size() * 2);
+    boost::algorithm::hex_lower(
+        addressBytes.begin(), addressBytes.end(), std::back_inserter(address));
+    return address;
+}
 
-    // always return 1
-    (void)_context;
-    (void)_addr;
-    return 1;
+size_t getCodeSize(evmc_host_context* _context, const evmc_address* _addr)
+{
+    auto& hostContext = static_cast<HostContext&>(*_context);
+    return hostContext.codeSizeAt(toHexAddress(*_addr));
 }
 
 evmc_bytes32 getCodeHash(evmc_host_context* _context, const evmc_address* _addr)
 {
-    //   auto &hostContext = static_cast<HostContext &>(*_context);
-    //   return toEvmC(hostContext.codeHashAt(fromEvmC(*_addr)));
-
-    // always return 0
-    (void)_context;
-    (void)_addr;
-    return toEvmC(h256());
+    auto& hostContext = static_cast<HostContext&>(*_context);
+    return toEvmC(hostContext.codeHashAt(toHexAddress(*_addr)));
 }
 
 /**
@@ -191,11 +191,8 @@ evmc_tx_context getTxContext(evmc_host_context* _context) noexcept
 
 evmc_bytes32 getBlockHash(evmc_host_context* _txContextPtr, int64_t _number)
 {
-    (void)_number;
-
     auto& hostContext = static_cast<HostContext&>(*_txContextPtr);
-    // return toEvmC(hostContext.blockHash(_number));
-    return toEvmC(hostContext.blockHash());
+    return toEvmC(hostContext.blockHash(_number));
 }
 
 // evmc_result create(HostContext& _txContext, evmc_message const* _msg) noexcept
@@ -264,7 +261,7 @@ int32_t get(evmc_host_context* _context, const uint8_t* _addr, int32_t _addressL
 
     // programming assert for debug
     assert(string_view((char*)_addr, _addressLength) == hostContext.myAddress());
-    auto value = hostContext.get(string((char*)_key, _keyLength));
+    auto value = hostContext.get(string_view((char*)_key, _keyLength));
     if (value.size() > (size_t)_valueLength)
     {
         return -1;
@@ -283,9 +280,10 @@ evmc_storage_status set(evmc_host_context* _context, const uint8_t* _addr, int32
     //     BOOST_THROW_EXCEPTION(PERMISSIONDENIED());
     // }
     assert(string_view((char*)_addr, _addressLength) == hostContext.myAddress());
-    string key((char*)_key, _keyLength);
-    string value((char*)_value, _valueLength);
-    auto oldValue = hostContext.get(string((char*)_key, _keyLength));
+    string_view key((char*)_key, _keyLength);
+    string_view value((char*)_value, _valueLength);
+    auto previous = hostContext.exchange(key, value);
+    auto oldValue = previous ? previous->getField(0) : string_view();
 
     if (value == oldValue)
         return EVMC_STORAGE_UNCHANGED;
@@ -298,7 +296,6 @@ evmc_storage_status set(evmc_host_context* _context, const uint8_t* _addr, int32
         status = EVMC_STORAGE_DELETED;
         hostContext.sub().refunds += hostContext.evmSchedule().sstoreRefundGas;
     }
-    hostContext.set(key, value);  // Interface uses native endianness
     return status;
 }
 
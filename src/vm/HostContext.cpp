@@ -22,6 +22,7 @@
 #include "HostContext.h"
 #include "../Common.h"
 #include "../executive/TransactionExecutive.h"
+#include "ContractCodeCache.h"
 #include "EVMHostInterface.h"
 #include "bcos-framework/interfaces/storage/Table.h"
 #include "bcos-framework/libstorage/StateStorage.h"
@@ -83,8 +84,10 @@ HostContext::HostContext(CallParameters::UniquePtr callParameters,
     std::shared_ptr<TransactionExecutive> executive, std::string tableName)
   : m_callParameters(std::move(callParameters)),
     m_executive(std::move(executive)),
-    m_tableName(tableName)
+    m_tableName(std::move(tableName))
 {
+    m_table = m_executive->internTable(m_tableName);
+
     interface = getHostInterface();
     wasm_interface = getWasmHostInterface();
 
@@ -99,15 +102,15 @@ HostContext::HostContext(CallParameters::UniquePtr callParameters,
     metrics = &ethMetrics;
 }
 
-std::string_view HostContext::get(const std::string_view& _key)
+std::string HostContext::get(const std::string_view& _key)
 {
-    auto entry = m_executive->storage().getRow(m_tableName, _key);
+    auto entry = m_executive->storage().getRow(m_table, _key);
     if (entry)
     {
-        return entry->getField(0);
+        return std::string(entry->getField(0));
     }
 
-    return std::string_view();
+    return std::string();
 }
 
 void HostContext::set(const std::string_view& _key, std::string _value)
@@ -115,7 +118,16 @@ void HostContext::set(const std::string_view& _key, std::string _value)
     Entry entry;
     entry.importFields({std::move(_value)});
 
-    m_executive->storage().setRow(m_tableName, _key, std::move(entry));
+    m_executive->storage().setRow(m_table, _key, std::move(entry));
+}
+
+std::optional<storage::Entry> HostContext::exchange(
+    const std::string_view& _key, const std::string_view& _value)
+{
+    return m_executive->storage().exchange(
+        m_table, _key, _value, [&_value](const std::optional<storage::Entry>& previous) {
+            return previous ? previous->getField(0) == _value : _value.empty();
+        });
 }
 
 evmc_result HostContext::externalRequest(const evmc_message* _msg)
@@ -146,7 +158,8 @@ evmc_result HostContext::externalRequest(const evmc_message* _msg)
         }
 
         request->codeAddress = request->receiveAddress;
-        request->data.assign(_msg->input_data, _msg->input_data + _msg->input_size);
+        // The memory of this frame stays unchanged until the callee returns
+        request->data = CallData::borrow(bytesConstRef(_msg->input_data, _msg->input_size));
         break;
     case EVMC_DELEGATECALL:
     case EVMC_CALLCODE:
@@ -179,8 +192,7 @@ evmc_result HostContext::externalRequest(const evmc_message* _msg)
     evmc_result result;
     result.status_code = evmc_status_code(response->status);
 
-    result.create_address =
-        toEvmC(boost::algorithm::unhex(response->newEVMContractAddress));  // TODO: check if ok
+    result.create_address = hexToEvmC(response->newEVMContractAddress);
 
     // TODO: check if the response data need to release
     result.output_data = response->data.data();
@@ -205,9 +217,9 @@ evmc_result HostContext::callBuiltInPrecompiled(
     if (_isEvmPrecompiled)
     {
         callResults->gas =
-            m_executive->costOfPrecompiled(_request->receiveAddress, ref(_request->data));
+            m_executive->costOfPrecompiled(_request->receiveAddress, _request->data.ref());
         auto [success, output] =
-            m_executive->executeOriginPrecompiled(_request->receiveAddress, ref(_request->data));
+            m_executive->executeOriginPrecompiled(_request->receiveAddress, _request->data.ref());
         resultCode =
             (int32_t)(success ? TransactionStatus::None : TransactionStatus::RevertInstruction);
         resultData.swap(output);
@@ -217,7 +229,7 @@ evmc_result HostContext::callBuiltInPrecompiled(
         try
         {
             auto precompiledResponse = m_executive->execPrecompiled(_request->receiveAddress,
-                ref(_request->data), _request->origin, _request->senderAddress);
+                _request->data.ref(), _request->origin, _request->senderAddress);
             callResults->gas = precompiledResponse->m_gas;
             resultCode = (int32_t)TransactionStatus::None;
             resultData.swap(precompiledResponse->m_execResult);
@@ -271,6 +283,23 @@ bool HostContext::setCode(bytes code)
         codeHashEntry.importFields({codeHash.asBytes()});
         m_executive->storage().setRow(m_tableName, ACCOUNT_CODE_HASH, std::move(codeHashEntry));
 
+        // The size as 8 big endian bytes followed by the hash, EXTCODESIZE reads only this row
+        bytes codeMeta(sizeof(uint64_t));
+        toBigEndian(uint64_t(code.size()), codeMeta);
+        codeMeta.insert(codeMeta.end(), codeHash.begin(), codeHash.end());
+        Entry codeMetaEntry;
+        codeMetaEntry.importFields({std::move(codeMeta)});
+        m_executive->storage().setRow(m_tableName, ACCOUNT_CODE_META, std::move(codeMetaEntry));
+
+        // The cache is keyed by code hash, warm it up for the coming calls instead of invalidating
+        auto& codeCache = m_executive->codeCache();
+        if (codeCache && !code.empty())
+        {
+            codeCache->insert(codeHash, std::make_shared<const bytes>(code));
+        }
+        m_code.reset();
+        m_codeHash = codeHash;
+
         Entry codeEntry;
         codeEntry.importFields({std::move(code)});
         m_executive->storage().setRow(m_tableName, ACCOUNT_CODE, std::move(codeEntry));
@@ -289,16 +318,73 @@ void HostContext::setCodeAndAbi(bytes code, string abi)
     }
 }
 
+bool HostContext::isPrecompiledAt(const std::string& _a) const
+{
+    return m_executive->isPrecompiled(_a) || m_executive->isBuiltInPrecompiled(_a) ||
+           m_executive->isEthereumPrecompiled(_a);
+}
+
 size_t HostContext::codeSizeAt(const std::string_view& _a)
 {
-    (void)_a;
-    return 1;  // TODO: 1 code size ok?
+    std::string address(_a);
+    // Precompiled contracts have no code, solidity refuses to call the contracts of empty code
+    if (isPrecompiledAt(address))
+    {
+        return 1;
+    }
+    if (!isCreate() && _a == myAddress())
+    {
+        return code().size();
+    }
+
+    // No contract at the address, e.g. an external account
+    auto tableName = m_executive->getContractTableName(address);
+    if (!m_executive->storage().openTable(tableName))
+    {
+        return 0;
+    }
+
+    // The metadata row never changes once written, it is read without key locks. Under
+    // construction if there is no code yet.
+    auto entry = m_executive->storage().getImmutableRow(tableName, ACCOUNT_CODE_META);
+    if (!entry)
+    {
+        return 0;
+    }
+    auto codeMeta = entry->getField(0);
+    return fromBigEndian<uint64_t>(codeMeta.substr(0, sizeof(uint64_t)));
 }
 
 h256 HostContext::codeHashAt(const std::string_view& _a)
 {
-    (void)_a;
-    return h256();  // TODO: ok?
+    std::string address(_a);
+    if (isPrecompiledAt(address))
+    {
+        return h256();
+    }
+    if (!isCreate() && _a == myAddress())
+    {
+        return codeHash();
+    }
+
+    auto tableName = m_executive->getContractTableName(address);
+    if (!m_executive->storage().openTable(tableName))
+    {
+        return h256();
+    }
+    return storedCodeHash(tableName);
+}
+
+h256 HostContext::storedCodeHash(const std::string_view& _tableName)
+{
+    auto entry = m_executive->storage().getImmutableRow(_tableName, ACCOUNT_CODE_HASH);
+    if (entry)
+    {
+        // The field is the raw bytes of the hash written by setCode
+        auto codeHash = entry->getField(0);
+        return h256(bytesConstRef((const bcos::byte*)codeHash.data(), codeHash.size()));
+    }
+    return h256();
 }
 
 u256 HostContext::store(const u256& _n)
@@ -306,7 +392,7 @@ u256 HostContext::store(const u256& _n)
     auto key = toEvmC(_n);
     auto keyView = std::string_view((char*)key.bytes, sizeof(key.bytes));
 
-    auto entry = m_executive->storage().getRow(m_tableName, keyView);
+    auto entry = m_executive->storage().getRow(m_table, keyView);
     if (entry)
     {
         return fromBigEndian<u256>(entry->getField(0));
@@ -326,7 +412,28 @@ void HostContext::setStore(u256 const& _n, u256 const& _v)
     Entry entry;
     entry.importFields({std::move(valueBytes)});
 
-    m_executive->storage().setRow(m_tableName, keyView, std::move(entry));
+    m_executive->storage().setRow(m_table, keyView, std::move(entry));
+}
+
+u256 HostContext::exchangeStore(const u256& _n, const u256& _v)
+{
+    auto key = toEvmC(_n);
+    auto keyView = std::string_view((char*)key.bytes, sizeof(key.bytes));
+
+    auto value = toEvmC(_v);
+    auto valueView = std::string_view((char*)value.bytes, sizeof(value.bytes));
+
+    u256 oldValue;
+    m_executive->storage().exchange(
+        m_table, keyView, valueView, [&](const std::optional<storage::Entry>& previous) {
+            if (previous)
+            {
+                oldValue = fromBigEndian<u256>(previous->getField(0));
+            }
+            return oldValue == _v;
+        });
+
+    return oldValue;
 }
 
 void HostContext::log(h256s&& _topics, bytesConstRef _data)
@@ -347,14 +454,20 @@ void HostContext::log(h256s&& _topics, bytesConstRef _data)
     //     m_sub.logs->push_back(
     //         protocol::LogEntry(asBytes(hexAddress), std::move(_topics), _data.toBytes()));
     // }
+    // The logs of a nested frame are cleared as it returns, don't copy them at all
+    if (m_callParameters->origin != m_callParameters->senderAddress)
+    {
+        return;
+    }
+
     m_callParameters->logEntries.emplace_back(
         bytes(myAddress().data(), myAddress().data() + myAddress().size()), std::move(_topics),
         _data.toBytes());
 }
 
-h256 HostContext::blockHash() const
+h256 HostContext::blockHash(int64_t _number) const
 {
-    return m_executive->blockContext().lock()->hash();
+    return m_executive->blockContext().lock()->blockHash(_number);
 }
 int64_t HostContext::blockNumber() const
 {
@@ -367,33 +480,63 @@ int64_t HostContext::timestamp() const
 
 std::string_view HostContext::myAddress() const
 {
-    return m_executive->contractAddress();
+    // Same as the executive's address, except for the frames of local calls
+    return m_callParameters->receiveAddress;
 }
 
 bytesConstRef HostContext::code()
 {
-    auto entry = m_executive->storage().getRow(m_tableName, ACCOUNT_CODE);
-    if (entry)
+    if (m_code)
+    {
+        return ref(*m_code);
+    }
+
+    auto& codeCache = m_executive->codeCache();
+    h256 hash;
+    if (codeCache)
+    {
+        // Conflict with the transactions deploying the contract as loading the code from storage
+        m_executive->storage().acquireKeyLock(m_table.hash, ACCOUNT_CODE);
+        hash = codeHash();
+    }
+    if (hash != h256())
     {
-        auto code = entry->getField(0);
+        m_code = codeCache->get(hash);
+        if (m_code)
+        {
+            return ref(*m_code);
+        }
+    }
 
-        return bytesConstRef((bcos::byte*)code.data(), code.size());
+    auto entry = m_executive->storage().getRow(m_tableName, ACCOUNT_CODE);
+    if (!entry)
+    {
+        return bytesConstRef();
     }
 
-    return bytesConstRef();
+    auto code = entry->getField(0);
+    m_code = std::make_shared<const bytes>(code.begin(), code.end());
+    if (hash != h256() && !m_code->empty())
+    {
+        codeCache->insert(hash, m_code);
+    }
+    return ref(*m_code);
 }
 
 h256 HostContext::codeHash()
 {
-    auto entry = m_executive->storage().getRow(m_tableName, ACCOUNT_CODE_HASH);
-    if (entry)
+    if (m_codeHash)
     {
-        auto code = entry->getField(0);
-
-        return h256(std::string(code));  // TODO: h256 support decode from string_view
+        return *m_codeHash;
     }
 
-    return h256();
+    // The code hash is written together with the code, they share the key lock of the code
+    auto codeHash = storedCodeHash(m_tableName);
+    if (codeHash != h256())
+    {
+        m_codeHash = codeHash;
+    }
+    return codeHash;
 }
 
 bool HostContext::registerAsset(const std::string& _assetName, const std::string_view& _addr,
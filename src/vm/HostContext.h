@@ -22,6 +22,7 @@
 #pragma once
 
 #include "../Common.h"
+#include "../executive/TableNameInterner.h"
 #include "bcos-framework/interfaces/storage/Table.h"
 #include "interfaces/protocol/BlockHeader.h"
 #include <evmc/evmc.h>
@@ -30,6 +31,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 
 namespace bcos
 {
@@ -51,10 +53,15 @@ public:
     HostContext(HostContext const&) = delete;
     HostContext& operator=(HostContext const&) = delete;
 
-    std::string_view get(const std::string_view& _key);
+    std::string get(const std::string_view& _key);
 
     void set(const std::string_view& _key, std::string _value);
 
+    /// Write a value in storage and return the previous row, the write is skipped if the value is
+    /// unchanged. A missing row reads as the empty value.
+    std::optional<storage::Entry> exchange(
+        const std::string_view& _key, const std::string_view& _value);
+
     bool registerAsset(const std::string& _assetName, const std::string_view& _issuer,
         bool _fungible, uint64_t _total, const std::string& _description);
     bool issueFungibleAsset(
@@ -78,6 +85,10 @@ public:
     /// Write a value in storage.
     void setStore(const u256& _n, const u256& _v);
 
+    /// Write a value in storage and return the previous value, the write is skipped if the value
+    /// is unchanged.
+    u256 exchangeStore(const u256& _n, const u256& _v);
+
     /// Create a new contract.
     evmc_result externalRequest(const evmc_message* _msg);
 
@@ -88,6 +99,8 @@ public:
 
     void setCodeAndAbi(bytes code, std::string abi);
 
+    /// Code size and code hash of the contract at the address, read from the metadata rows
+    /// written by setCode without loading the code. An address with no contract has size 0.
     size_t codeSizeAt(const std::string_view& _a);
 
     h256 codeHashAt(const std::string_view& _a);
@@ -99,7 +112,7 @@ public:
     EVMSchedule const& evmSchedule() const { return m_evmSchedule; }
 
     /// Hash of a block if within the last 256 blocks, or h256() otherwise.
-    h256 blockHash() const;
+    h256 blockHash(int64_t _number) const;
     int64_t blockNumber() const;
     int64_t timestamp() const;
     int64_t blockGasLimit() const
@@ -117,7 +130,9 @@ public:
     std::string_view caller() const { return m_callParameters->senderAddress; }
     std::string_view origin() const { return m_callParameters->origin; }
     std::string_view codeAddress() const { return m_callParameters->codeAddress; }
-    bytesConstRef data() const { return ref(m_callParameters->data); }
+    bytesConstRef data() const { return m_callParameters->data.ref(); }
+    /// The code is loaded once and held until the frame finishes, the reference stays valid after
+    /// external calls.
     bytesConstRef code();
     h256 codeHash();
     u256 salt() const { return m_salt; }
@@ -131,6 +146,11 @@ public:
     static crypto::Hash::Ptr hashImpl() { return GlobalHashImpl::g_hashImpl; }
 
 private:
+    bool isPrecompiledAt(const std::string& _a) const;
+
+    // The code hash written by setCode in the contract table, h256() if no code
+    h256 storedCodeHash(const std::string_view& _tableName);
+
     void depositFungibleAsset(
         const std::string_view& _to, const std::string& _assetName, uint64_t _amount);
     void depositNotFungibleAsset(const std::string_view& _to, const std::string& _assetName,
@@ -139,12 +159,17 @@ private:
     CallParameters::UniquePtr m_callParameters;
     std::shared_ptr<TransactionExecutive> m_executive;
     std::string m_tableName;
+    InternedTable m_table;  // m_tableName interned by the executive, for the storage hot path
 
     u256 m_salt;     ///< Values used in new address construction by CREATE2
     SubState m_sub;  ///< Sub-band VM state (suicides, refund counter, logs).
 
     std::list<CallParameters::UniquePtr> m_responseStore;
 
+    // Code of this contract shared with the code cache, loaded on first use
+    std::shared_ptr<const bytes> m_code;
+    std::optional<h256> m_codeHash;
+
     static EVMSchedule m_evmSchedule;
 };
 
@@ -26,6 +26,7 @@
 #include <evmone/evmone.h>
 #include <hera/hera.h>
 #include <boost/program_options.hpp>
+#include <array>
 
 namespace po = boost::program_options;
 
@@ -53,6 +54,43 @@ struct VMKindTableEntry
     const char* name;
 };
 
+/// The idle instances of every VMKind, the instances keep no state between executions so they are
+/// reused by the frames executed on the same thread instead of create/destroy per execution.
+struct VMInstancePool
+{
+    ~VMInstancePool()
+    {
+        for (auto& instances : idle)
+        {
+            for (auto instance : instances)
+            {
+                instance->destroy(instance);
+            }
+        }
+    }
+
+    std::vector<evmc_vm*>& operator[](VMKind _kind) { return idle[static_cast<size_t>(_kind)]; }
+
+    std::array<std::vector<evmc_vm*>, static_cast<size_t>(VMKind::DLL) + 1> idle;
+};
+
+thread_local VMInstancePool t_vmInstancePool;
+
+evmc_vm* createEVMC(VMKind _kind)
+{
+    switch (_kind)
+    {
+    case VMKind::Hera:
+        return evmc_create_hera();
+    case VMKind::evmone:
+        return evmc_create_evmone();
+    case VMKind::DLL:
+        return g_evmcCreateFn();
+    default:
+        return evmc_create_evmone();
+    }
+}
+
 /// The table of available VM implementations.
 
 #if 0
@@ -98,17 +136,40 @@ VMInstance VMFactory::create()
 
 VMInstance VMFactory::create(VMKind _kind)
 {
-    switch (_kind)
+    auto& instances = t_vmInstancePool[_kind];
+    if (!instances.empty())
     {
-    case VMKind::Hera:
-        return VMInstance{evmc_create_hera()};
-    case VMKind::evmone:
-        return VMInstance{evmc_create_evmone()};
-    case VMKind::DLL:
-        return VMInstance{g_evmcCreateFn()};
-    default:
-        return VMInstance{evmc_create_evmone()};
+        auto instance = instances.back();
+        instances.pop_back();
+        return VMInstance{instance, _kind};
+    }
+
+    auto instance = createEVMC(_kind);
+    applyEvmcOptions(instance);
+    return VMInstance{instance, _kind};
+}
+
+void VMFactory::recycle(VMKind _kind, evmc_vm* _instance) noexcept
+{
+    // The frame may be resumed by another thread after an external call, the instance is pooled by
+    // the thread which finishes the frame
+    auto& instances = t_vmInstancePool[_kind];
+    if (instances.size() < c_maxPooledInstances)
+    {
+        try
+        {
+            instances.push_back(_instance);
+            return;
+        }
+        catch (...)
+        {}
     }
+    _instance->destroy(_instance);
+}
+
+size_t VMFactory::pooledInstances(VMKind _kind) noexcept
+{
+    return t_vmInstancePool[_kind].size();
 }
 }  // namespace executor
 }  // namespace bcos
@@ -20,6 +20,7 @@
  */
 
 #pragma once
+#include <evmc/evmc.h>
 #include <string>
 #include <memory>
 #include <vector>
@@ -45,8 +46,18 @@ public:
     /// Creates a VM instance of the global kind.
     static VMInstance create();
 
-    /// Creates a VM instance of the kind provided.
+    /// Creates a VM instance of the kind provided, the instance is borrowed from the pool of the
+    /// current thread when there is an idle one.
     static VMInstance create(VMKind _kind);
+
+    /// Hands the instance back to the pool of the current thread, destroys it if the pool is full.
+    static void recycle(VMKind _kind, evmc_vm* _instance) noexcept;
+
+    /// The number of idle instances of the kind pooled by the current thread.
+    static size_t pooledInstances(VMKind _kind) noexcept;
+
+    /// The maximum idle instances of every kind pooled by one thread.
+    static constexpr size_t c_maxPooledInstances = 16;
 };
 }  // namespace executor
 }  // namespace bcos
@@ -39,16 +39,33 @@ std::vector<std::pair<std::string, std::string>>& evmcOptions() noexcept
     return s_evmcOptions;
 }
 
-VMInstance::VMInstance(evmc_vm* _instance) noexcept : m_instance(_instance)
+void applyEvmcOptions(evmc_vm* _instance) noexcept
 {
-    assert(m_instance != nullptr);
+    assert(_instance != nullptr);
     // the abi_version of intepreter is EVMC_ABI_VERSION when callback VMFactory::create()
-    assert(m_instance->abi_version == EVMC_ABI_VERSION);
+    assert(_instance->abi_version == EVMC_ABI_VERSION);
 
     // Set the options.
-    if (m_instance->set_option)
+    if (_instance->set_option)
         for (auto& pair : evmcOptions())
-            m_instance->set_option(m_instance, pair.first.c_str(), pair.second.c_str());
+            _instance->set_option(_instance, pair.first.c_str(), pair.second.c_str());
+}
+
+VMInstance::VMInstance(evmc_vm* _instance) noexcept : m_instance(_instance)
+{
+    applyEvmcOptions(m_instance);
+}
+
+VMInstance::~VMInstance()
+{
+    if (m_pooled)
+    {
+        VMFactory::recycle(m_kind, m_instance);
+    }
+    else
+    {
+        m_instance->destroy(m_instance);
+    }
 }
 
 Result VMInstance::exec(HostContext& _hostContext, evmc_revision _rev, evmc_message* _msg,
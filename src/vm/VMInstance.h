@@ -21,6 +21,7 @@
 
 #pragma once
 #include "../Common.h"
+#include "VMFactory.h"
 #include "bcos-framework/libutilities/Common.h"
 #include <evmc/evmc.h>
 
@@ -56,6 +57,9 @@ public:
 /// Returns the EVM-C options parsed from command line.
 std::vector<std::pair<std::string, std::string>>& evmcOptions() noexcept;
 
+/// Apply the EVM-C options parsed from command line to the instance.
+void applyEvmcOptions(evmc_vm* _instance) noexcept;
+
 /// Translate the EVMSchedule to VMInstance-C revision.
 evmc_revision toRevision(EVMSchedule const& _schedule);
 
@@ -64,7 +68,14 @@ class VMInstance
 {
 public:
     explicit VMInstance(evmc_vm* _instance) noexcept;
-    ~VMInstance() { m_instance->destroy(m_instance); }
+
+    /// Borrow an instance pooled by VMFactory, the options have been applied when it was created,
+    /// the instance is handed back to the pool of the current thread on destruction.
+    VMInstance(evmc_vm* _instance, VMKind _kind) noexcept
+      : m_instance(_instance), m_kind(_kind), m_pooled(true)
+    {}
+
+    ~VMInstance();
 
     VMInstance(VMInstance const&) = delete;
     VMInstance& operator=(VMInstance) = delete;
@@ -77,6 +88,8 @@ public:
 private:
     /// The VM instance created with VMInstance-C <prefix>_create() function.
     evmc_vm* m_instance = nullptr;
+    VMKind m_kind = VMKind::evmone;
+    bool m_pooled = false;
 };
 
 }  // namespace executor
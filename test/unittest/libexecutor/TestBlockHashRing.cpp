@@ -0,0 +1,138 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+/**
+ * @brief : unitest for the ring of the recent block hashes
+ */
+
+#include "../src/executive/BlockContext.h"
+#include "../src/executive/BlockHashRing.h"
+#include "libstorage/StateStorage.h"
+#include <bcos-framework/testutils/crypto/HashImpl.h>
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <string>
+
+using namespace std;
+using namespace bcos;
+using namespace bcos::executor;
+
+namespace bcos
+{
+namespace test
+{
+struct BlockHashRingFixture
+{
+    BlockHashRing<std::string, 4> ring;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestBlockHashRing, BlockHashRingFixture)
+
+BOOST_AUTO_TEST_CASE(InsertAndGet)
+{
+    BOOST_CHECK(!ring.get(0));
+    BOOST_CHECK(!ring.get(-1));
+
+    ring.insert(0, "hash0");
+    ring.insert(1, "hash1");
+    BOOST_CHECK_EQUAL(*ring.get(0), "hash0");
+    BOOST_CHECK_EQUAL(*ring.get(1), "hash1");
+    BOOST_CHECK(!ring.contains(2));
+
+    // A negative number is never inserted
+    ring.insert(-1, "invalid");
+    BOOST_CHECK(!ring.contains(-1));
+    BOOST_CHECK(!ring.get(3));
+}
+
+BOOST_AUTO_TEST_CASE(Overwrite)
+{
+    for (int64_t i = 0; i < 10; ++i)
+    {
+        ring.insert(i, "hash" + std::to_string(i));
+    }
+
+    // Only the last 4 blocks are kept, the older ones share their slots
+    for (int64_t i = 0; i < 6; ++i)
+    {
+        BOOST_CHECK(!ring.get(i));
+    }
+    for (int64_t i = 6; i < 10; ++i)
+    {
+        BOOST_CHECK_EQUAL(*ring.get(i), "hash" + std::to_string(i));
+    }
+    BOOST_CHECK(!ring.get(10));
+    BOOST_CHECK(!ring.get(14));
+
+    // Inserting again, e.g. a parent already loaded, replaces the hash
+    ring.insert(9, "other");
+    BOOST_CHECK_EQUAL(*ring.get(9), "other");
+}
+
+BOOST_AUTO_TEST_CASE(Copy)
+{
+    ring.insert(1, "hash1");
+    auto next = ring;
+    next.insert(5, "hash5");
+
+    // The copy of the next block doesn't change the ring read by the previous block
+    BOOST_CHECK_EQUAL(*ring.get(1), "hash1");
+    BOOST_CHECK(!ring.get(5));
+    BOOST_CHECK(!next.get(1));
+    BOOST_CHECK_EQUAL(*next.get(5), "hash5");
+}
+
+BOOST_AUTO_TEST_CASE(BlockContextBounds)
+{
+    auto hashImpl = std::make_shared<Keccak256Hash>();
+    auto storage = std::make_shared<storage::StateStorage>(nullptr);
+    BlockContext blockContext(
+        storage, hashImpl, 300, h256(), 0, 0, FiscoBcosScheduleV3, false, false);
+
+    auto hashOf = [&hashImpl](int64_t number) {
+        auto data = std::to_string(number);
+        return hashImpl->hash(bytesConstRef((const byte*)data.data(), data.size()));
+    };
+
+    // No ring, e.g. a context not created by the executor
+    BOOST_CHECK(blockContext.blockHash(299) == h256());
+
+    auto blockHashes = std::make_shared<BlockContext::BlockHashes>();
+    for (int64_t i = 0; i < 300; ++i)
+    {
+        if (i != 250)
+        {
+            blockHashes->insert(i, hashOf(i));
+        }
+    }
+    blockContext.setBlockHashes(blockHashes);
+
+    // The 256 blocks before the current one
+    BOOST_CHECK(blockContext.blockHash(299) == hashOf(299));
+    BOOST_CHECK(blockContext.blockHash(44) == hashOf(44));
+    BOOST_CHECK(blockContext.blockHash(43) == h256());
+
+    // Not known
+    BOOST_CHECK(blockContext.blockHash(250) == h256());
+
+    // The current block, the future ones and the negative numbers
+    BOOST_CHECK(blockContext.blockHash(300) == h256());
+    BOOST_CHECK(blockContext.blockHash(301) == h256());
+    BOOST_CHECK(blockContext.blockHash(-1) == h256());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
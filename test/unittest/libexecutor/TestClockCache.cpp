@@ -148,6 +148,38 @@ BOOST_AUTO_TEST_CASE(EvictionPolicy)
     BOOST_CHECK(bigCache->lookup(203).value() == 204);
 }
 
+BOOST_AUTO_TEST_CASE(EvictionByCharge)
+{
+    // The capacity of this cache is 100 bytes with 1 shard.
+    auto bytesCache = make_shared<ClockCache<int, int>>(100, 0);
+
+    BOOST_CHECK(bytesCache->insert(1, new int(1), nullptr, 60));
+    BOOST_CHECK_EQUAL(bytesCache->usage(), 60);
+
+    // No room for both entries, the first one is evicted
+    BOOST_CHECK(bytesCache->insert(2, new int(2), nullptr, 50));
+    BOOST_CHECK_EQUAL(bytesCache->usage(), 50);
+    BOOST_CHECK(!bytesCache->lookup(1).isValid());
+
+    // Larger than the whole capacity
+    auto tooLarge = std::make_unique<int>(3);
+    BOOST_CHECK(!bytesCache->insert(3, tooLarge.get(), nullptr, 101));
+    BOOST_CHECK_EQUAL(bytesCache->usage(), 50);
+
+    // The referenced entry cannot be evicted
+    auto handle = bytesCache->lookup(2);
+    BOOST_CHECK(handle.isValid());
+    auto noRoom = std::make_unique<int>(4);
+    BOOST_CHECK(!bytesCache->insert(4, noRoom.get(), nullptr, 60));
+    BOOST_CHECK(bytesCache->insert(5, new int(5), nullptr, 50));
+    BOOST_CHECK_EQUAL(bytesCache->usage(), 100);
+
+    handle.release();
+    BOOST_CHECK(bytesCache->insert(4, noRoom.release(), nullptr, 60));
+    BOOST_CHECK_LE(bytesCache->usage(), 100);
+    BOOST_CHECK_EQUAL(bytesCache->lookup(4).value(), 4);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace bcos
@@ -0,0 +1,100 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+/**
+ * @brief : unitest for pooled coroutine stacks
+ */
+
+#include "../src/executive/CoroutineStackPool.h"
+#include <boost/coroutine2/all.hpp>
+#include <boost/test/unit_test.hpp>
+#include <memory>
+
+using namespace std;
+using namespace bcos;
+using namespace bcos::executor;
+
+namespace bcos
+{
+namespace test
+{
+struct CoroutineStackPoolFixture
+{
+    CoroutineStackPoolFixture() { pool = make_shared<CoroutineStackPool>(64 * 1024, 2); }
+
+    CoroutineStackPool::Ptr pool;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestCoroutineStackPool, CoroutineStackPoolFixture)
+
+BOOST_AUTO_TEST_CASE(RecycleStack)
+{
+    BOOST_CHECK_EQUAL(pool->stackSize(), 64 * 1024);
+    BOOST_CHECK_EQUAL(pool->cachedStacks(), 0);
+
+    auto stack = pool->allocate();
+    BOOST_CHECK(stack.sp);
+    BOOST_CHECK_GT(stack.size, pool->stackSize());
+    auto sp = stack.sp;
+
+    pool->deallocate(stack);
+    BOOST_CHECK_EQUAL(pool->cachedStacks(), 1);
+
+    auto reused = pool->allocate();
+    BOOST_CHECK_EQUAL(reused.sp, sp);
+    BOOST_CHECK_EQUAL(pool->cachedStacks(), 0);
+    pool->deallocate(reused);
+}
+
+BOOST_AUTO_TEST_CASE(MaxCachedStacks)
+{
+    auto stack1 = pool->allocate();
+    auto stack2 = pool->allocate();
+    auto stack3 = pool->allocate();
+
+    pool->deallocate(stack1);
+    pool->deallocate(stack2);
+    pool->deallocate(stack3);
+
+    BOOST_CHECK_EQUAL(pool->cachedStacks(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(RunCoroutine)
+{
+    using Coroutine = boost::coroutines2::coroutine<int>;
+
+    for (int round = 0; round < 10; ++round)
+    {
+        Coroutine::pull_type source(pool->allocator(), [](Coroutine::push_type& sink) {
+            for (int i = 0; i < 3; ++i)
+            {
+                sink(i);
+            }
+        });
+
+        int expected = 0;
+        for (auto value : source)
+        {
+            BOOST_CHECK_EQUAL(value, expected++);
+        }
+        BOOST_CHECK_EQUAL(expected, 3);
+    }
+
+    BOOST_CHECK_EQUAL(pool->cachedStacks(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -21,6 +21,8 @@
 
 #include "../mock/MockTransactionalStorage.h"
 #include "../mock/MockTxPool.h"
+#include "../src/executive/KeyLocks.h"
+#include "../src/executor/CallResultCache.h"
 #include "Common.h"
 #include "bcos-executor/LRUStorage.h"
 #include "bcos-executor/TransactionExecutor.h"
@@ -93,6 +95,39 @@ struct TransactionExecutorFixture
         codec = std::make_unique<bcos::precompiled::PrecompiledCodec>(hashImpl, false);
     }
 
+    // Deploy the creation code in a transaction of the current block, returns the new address
+    std::string deploy(const bytes& input, int64_t contextID, const std::string& address)
+    {
+        auto tx = fakeTransaction(cryptoSuite, keyPair, "", input, contextID, 100001, "1", "1");
+        auto sender = *toHexString(string_view((char*)tx->sender().data(), tx->sender().size()));
+        auto hash = tx->hash();
+        txpool->hash2Transaction.emplace(hash, tx);
+
+        auto params = std::make_unique<NativeExecutionMessage>();
+        params->setContextID(contextID);
+        params->setSeq(1000);
+        params->setDepth(0);
+        params->setOrigin(sender);
+        params->setFrom(sender);
+        params->setTo(std::string(address));
+        params->setStaticCall(false);
+        params->setGasAvailable(gas);
+        params->setType(NativeExecutionMessage::TXHASH);
+        params->setTransactionHash(hash);
+        params->setCreate(true);
+
+        std::promise<ExecutionMessage::UniquePtr> executePromise;
+        executor->executeTransaction(std::move(params),
+            [&](bcos::Error::UniquePtr&& error, ExecutionMessage::UniquePtr&& result) {
+                BOOST_CHECK(!error);
+                executePromise.set_value(std::move(result));
+            });
+        auto result = executePromise.get_future().get();
+        BOOST_CHECK_EQUAL(result->type(), ExecutionMessage::FINISHED);
+        BOOST_CHECK_EQUAL(result->status(), 0);
+        return std::string(result->newEVMContractAddress());
+    }
+
     TransactionExecutor::Ptr executor;
     CryptoSuite::Ptr cryptoSuite;
     std::shared_ptr<MockTxPool> txpool;
@@ -244,6 +279,13 @@ BOOST_AUTO_TEST_CASE(deployAndCall)
     BOOST_CHECK(entry);
     BOOST_CHECK_GT(entry->getField(0).size(), 0);
 
+    auto codeMetaEntry = table.getRow("codeMeta");
+    BOOST_CHECK(codeMetaEntry);
+    auto codeMeta = codeMetaEntry->getField(0);
+    BOOST_CHECK_EQUAL(codeMeta.size(), sizeof(uint64_t) + h256::size);
+    BOOST_CHECK_EQUAL(
+        fromBigEndian<uint64_t>(codeMeta.substr(0, sizeof(uint64_t))), entry->getField(0).size());
+
     // start new block
     auto blockHeader2 = std::make_shared<bcos::protocol::PBBlockHeader>(cryptoSuite);
     blockHeader2->setNumber(2);
@@ -467,7 +509,8 @@ BOOST_AUTO_TEST_CASE(externalCall)
     BOOST_CHECK(result2->to().empty());
     BOOST_CHECK_LT(result2->gasAvailable(), gas);
     BOOST_CHECK_EQUAL(result2->keyLocks().size(), 1);
-    BOOST_CHECK_EQUAL(result2->keyLocks()[0], "code");
+    BOOST_CHECK(
+        result2->keyLocks()[0] == KeyLockSet::encode(getContractTableName(address), "code"));
 
     // --------------------------------
     // Message 1: Create contract B, set new seq 1002
@@ -527,7 +570,9 @@ BOOST_AUTO_TEST_CASE(externalCall)
     BOOST_CHECK_EQUAL(result4->from(), std::string(address));
     BOOST_CHECK_EQUAL(result4->to(), boost::algorithm::to_lower_copy(std::string(addressString2)));
     BOOST_CHECK_EQUAL(result4->keyLocks().size(), 1);
-    BOOST_CHECK_EQUAL(toHex(result4->keyLocks()[0]), h256(0).hex());  // first member
+    // first member
+    BOOST_CHECK(result4->keyLocks()[0] ==
+                KeyLockSet::encode(getContractTableName(address), std::string(32, 0)));
 
     // Request message without status
     // BOOST_CHECK_EQUAL(result4->status(), 0);
@@ -661,6 +706,41 @@ BOOST_AUTO_TEST_CASE(externalCall)
 
     auto expectResult2 = codec->encode(s256(1000));
     BOOST_CHECK(callResult2->data().toBytes() == expectResult);
+
+    // The same call again and again, answered by the result cache after the first time
+    executor->setCallResultCacheCapacity(1024 * 1024);
+    for (int64_t contextID = 502; contextID < 505; ++contextID)
+    {
+        auto callParam3 = std::make_unique<NativeExecutionMessage>();
+        callParam3->setType(executor::NativeExecutionMessage::MESSAGE);
+        callParam3->setContextID(contextID);
+        callParam3->setSeq(7780);
+        callParam3->setDepth(0);
+        callParam3->setFrom(std::string(sender));
+        callParam3->setTo(boost::algorithm::to_lower_copy(std::string(addressString2)));
+        callParam3->setData(codec->encodeWithSig("value()"));
+        callParam3->setOrigin(std::string(sender));
+        callParam3->setStaticCall(true);
+        callParam3->setGasAvailable(gas);
+        callParam3->setCreate(false);
+
+        bcos::protocol::ExecutionMessage::UniquePtr callResult3;
+        executor->call(std::move(callParam3), [&](bcos::Error::UniquePtr error,
+                                                  bcos::protocol::ExecutionMessage::UniquePtr
+                                                      response) {
+            BOOST_CHECK(!error);
+            callResult3 = std::move(response);
+        });
+
+        BOOST_CHECK_EQUAL(callResult3->type(), protocol::ExecutionMessage::FINISHED);
+        BOOST_CHECK_EQUAL(callResult3->status(), 0);
+        BOOST_CHECK_EQUAL(callResult3->contextID(), contextID);
+        BOOST_CHECK_EQUAL(callResult3->seq(), 7780);
+        BOOST_CHECK_EQUAL(callResult3->to(), sender);
+        BOOST_CHECK(callResult3->data().toBytes() == expectResult);
+    }
+    BOOST_CHECK_EQUAL(executor->callResultCache()->misses(), 1);
+    BOOST_CHECK_EQUAL(executor->callResultCache()->hits(), 2);
 }
 
 BOOST_AUTO_TEST_CASE(performance)
@@ -1034,6 +1114,874 @@ BOOST_AUTO_TEST_CASE(multiDeploy)
 
 BOOST_AUTO_TEST_CASE(keyLock) {}
 
+BOOST_AUTO_TEST_CASE(lazyCoroutine)
+{
+    executor->setLazyCoroutine(true);
+    BOOST_CHECK(executor->lazyCoroutine());
+
+    std::string ABin =
+        "608060405234801561001057600080fd5b5061037f806100206000396000f3fe60806040523480156100105760"
+        "0080fd5b506004361061002b5760003560e01c80635b975a7314610030575b600080fd5b61005c600480360360"
+        "2081101561004657600080fd5b8101908080359060200190929190505050610072565b60405180828152602001"
+        "91505060405180910390f35b600081604051610081906101c7565b808281526020019150506040518091039060"
+        "00f0801580156100a7573d6000803e3d6000fd5b506000806101000a81548173ffffffffffffffffffffffffff"
+        "ffffffffffffff021916908373ffffffffffffffffffffffffffffffffffffffff1602179055507fd8e189e965"
+        "f1ff506594c5c65110ea4132cee975b58710da78ea19bc094414ae826040518082815260200191505060405180"
+        "910390a16000809054906101000a900473ffffffffffffffffffffffffffffffffffffffff1673ffffffffffff"
+        "ffffffffffffffffffffffffffff16633fa4f2456040518163ffffffff1660e01b815260040160206040518083"
+        "038186803b15801561018557600080fd5b505afa158015610199573d6000803e3d6000fd5b505050506040513d"
+        "60208110156101af57600080fd5b81019080805190602001909291905050509050919050565b610175806101d5"
+        "8339019056fe608060405234801561001057600080fd5b50604051610175380380610175833981810160405260"
+        "2081101561003357600080fd5b8101908080519060200190929190505050806000819055507fdc509bfccbee28"
+        "6f248e0904323788ad0c0e04e04de65c04b482b056acb1a0658160405180828152602001915050604051809103"
+        "90a15060e4806100916000396000f3fe6080604052348015600f57600080fd5b506004361060325760003560e0"
+        "1c80633fa4f245146037578063a16fe09b146053575b600080fd5b603d605b565b604051808281526020019150"
+        "5060405180910390f35b60596064565b005b60008054905090565b6000808154600101919050819055507f052f"
+        "6b9dfac9e4e1257cb5b806b7673421c54730f663c8ab02561743bb23622d600054604051808281526020019150"
+        "5060405180910390a156fea264697066735822122006eea3bbe24f3d859a9cb90efc318f26898aeb4dffb31cac"
+        "e105776a6c272f8464736f6c634300060a0033a2646970667358221220b441da8ba792a40e444d0ed767a4417e"
+        "944c55578d1c8d0ca4ad4ec050e05a9364736f6c634300060a0033";
+
+    bytes input;
+    boost::algorithm::unhex(ABin, std::back_inserter(input));
+    auto tx = fakeTransaction(cryptoSuite, keyPair, "", input, 101, 100001, "1", "1");
+    auto sender = boost::algorithm::hex_lower(std::string(tx->sender()));
+
+    auto hash = tx->hash();
+    txpool->hash2Transaction.emplace(hash, tx);
+
+    auto params = std::make_unique<NativeExecutionMessage>();
+    params->setContextID(100);
+    params->setSeq(1000);
+    params->setDepth(0);
+    params->setOrigin(std::string(sender));
+    params->setFrom(std::string(sender));
+    h256 addressCreate("ff6f30856ad3bae00b1169808488502786a13e3c174d85682135ffd51310310e");
+    params->setTo(addressCreate.hex().substr(0, 40));
+    params->setStaticCall(false);
+    params->setGasAvailable(gas);
+    params->setData(input);
+    params->setType(NativeExecutionMessage::TXHASH);
+    params->setTransactionHash(hash);
+    params->setCreate(true);
+
+    auto blockHeader = std::make_shared<bcos::protocol::PBBlockHeader>(cryptoSuite);
+    blockHeader->setNumber(1);
+
+    std::promise<void> nextPromise;
+    executor->nextBlockHeader(blockHeader, [&](bcos::Error::Ptr&& error) {
+        BOOST_CHECK(!error);
+        nextPromise.set_value();
+    });
+    nextPromise.get_future().get();
+
+    // Create contract A, the code of B in its init code has CREATE, executed in coroutine
+    std::promise<bcos::protocol::ExecutionMessage::UniquePtr> executePromise;
+    executor->executeTransaction(std::move(params),
+        [&](bcos::Error::UniquePtr&& error, bcos::protocol::ExecutionMessage::UniquePtr&& result) {
+            BOOST_CHECK(!error);
+            executePromise.set_value(std::move(result));
+        });
+    auto result = executePromise.get_future().get();
+
+    auto address = result->newEVMContractAddress();
+    BOOST_CHECK_EQUAL(result->type(), NativeExecutionMessage::FINISHED);
+    BOOST_CHECK_EQUAL(result->status(), 0);
+    BOOST_CHECK_GT(address.size(), 0);
+
+    // Call A createAndCallB(int256), the code of A has CREATE and CALL, executed in coroutine
+    auto params2 = std::make_unique<NativeExecutionMessage>();
+    params2->setContextID(101);
+    params2->setSeq(1001);
+    params2->setDepth(0);
+    params2->setFrom(std::string(sender));
+    params2->setTo(std::string(address));
+    params2->setOrigin(std::string(sender));
+    params2->setStaticCall(false);
+    params2->setGasAvailable(gas);
+    params2->setCreate(false);
+    bcos::u256 value(1000);
+    params2->setData(codec->encodeWithSig("createAndCallB(int256)", value));
+    params2->setType(NativeExecutionMessage::MESSAGE);
+
+    std::promise<ExecutionMessage::UniquePtr> executePromise2;
+    executor->executeTransaction(std::move(params2),
+        [&](bcos::Error::UniquePtr&& error, NativeExecutionMessage::UniquePtr&& result) {
+            BOOST_CHECK(!error);
+            executePromise2.set_value(std::move(result));
+        });
+    auto result2 = executePromise2.get_future().get();
+
+    BOOST_CHECK(result2);
+    BOOST_CHECK_EQUAL(result2->type(), ExecutionMessage::MESSAGE);
+    BOOST_CHECK_EQUAL(result2->contextID(), 101);
+    BOOST_CHECK_EQUAL(result2->seq(), 1001);
+    BOOST_CHECK_EQUAL(result2->create(), true);
+    BOOST_CHECK_EQUAL(result2->from(), std::string(address));
+    BOOST_CHECK_LT(result2->gasAvailable(), gas);
+    BOOST_CHECK_EQUAL(result2->keyLocks().size(), 1);
+    BOOST_CHECK(
+        result2->keyLocks()[0] == KeyLockSet::encode(getContractTableName(address), "code"));
+}
+
+BOOST_AUTO_TEST_CASE(localCall)
+{
+    // B from test_external_call.sol, value() returns the value passed to the constructor
+    std::string BBin =
+        "608060405234801561001057600080fd5b50604051610175380380610175833981810160405260208110156100"
+        "3357600080fd5b8101908080519060200190929190505050806000819055507fdc509bfccbee286f248e090432"
+        "3788ad0c0e04e04de65c04b482b056acb1a065816040518082815260200191505060405180910390a15060e480"
+        "6100916000396000f3fe6080604052348015600f57600080fd5b506004361060325760003560e01c80633fa4f2"
+        "45146037578063a16fe09b146053575b600080fd5b603d605b565b604051808281526020019150506040518091"
+        "0390f35b60596064565b005b60008054905090565b6000808154600101919050819055507f052f6b9dfac9e4e1"
+        "257cb5b806b7673421c54730f663c8ab02561743bb23622d600054604051808281526020019150506040518091"
+        "0390a156fea264697066735822122006eea3bbe24f3d859a9cb90efc318f26898aeb4dffb31cace105776a6c27"
+        "2f8464736f6c634300060a0033";
+
+    // Returns staticcall(gas(), calldataload(0), value()) of the address passed in
+    std::string callerBin =
+        "603780600b6000396000f3"
+        "7f3fa4f24500000000000000000000000000000000000000000000000000000000"
+        "600052"
+        "6020600060046000"
+        "600035"
+        "5afa"
+        "50"
+        "60206000f3";
+
+    auto blockHeader = std::make_shared<bcos::protocol::PBBlockHeader>(cryptoSuite);
+    blockHeader->setNumber(1);
+    std::promise<void> nextPromise;
+    executor->nextBlockHeader(blockHeader, [&](bcos::Error::Ptr&& error) {
+        BOOST_CHECK(!error);
+        nextPromise.set_value();
+    });
+    nextPromise.get_future().get();
+
+    bytes BInput;
+    boost::algorithm::unhex(BBin, std::back_inserter(BInput));
+    auto value = codec->encode(s256(1000));
+    BInput.insert(BInput.end(), value.begin(), value.end());
+    auto BAddress = deploy(BInput, 100, "ee6f30856ad3bae00b1169808488502786a13e3c");
+
+    bytes callerInput;
+    boost::algorithm::unhex(callerBin, std::back_inserter(callerInput));
+    auto callerAddress = deploy(callerInput, 101, "ff6f30856ad3bae00b1169808488502786a13e3c");
+
+    bcos::executor::TransactionExecutor::TwoPCParams commitParams{};
+    commitParams.number = 1;
+    executor->prepare(commitParams, [](bcos::Error::Ptr error) { BOOST_CHECK(!error); });
+    executor->commit(commitParams, [](bcos::Error::Ptr error) { BOOST_CHECK(!error); });
+
+    auto call = [&](int64_t contextID) {
+        bytes data(12, 0);
+        boost::algorithm::unhex(BAddress, std::back_inserter(data));
+
+        auto callParam = std::make_unique<NativeExecutionMessage>();
+        callParam->setType(NativeExecutionMessage::MESSAGE);
+        callParam->setContextID(contextID);
+        callParam->setSeq(1000);
+        callParam->setDepth(0);
+        callParam->setFrom(std::string(callerAddress));
+        callParam->setTo(std::string(callerAddress));
+        callParam->setOrigin(std::string(callerAddress));
+        callParam->setData(std::move(data));
+        callParam->setStaticCall(true);
+        callParam->setGasAvailable(gas);
+        callParam->setCreate(false);
+
+        bcos::protocol::ExecutionMessage::UniquePtr callResult;
+        executor->call(std::move(callParam),
+            [&](bcos::Error::UniquePtr error, ExecutionMessage::UniquePtr response) {
+                BOOST_CHECK(!error);
+                callResult = std::move(response);
+            });
+        return callResult;
+    };
+
+    // Disabled by default, the nested call goes to the scheduler
+    BOOST_CHECK_EQUAL(executor->maxLocalCallDepth(), 0);
+    auto remoteResult = call(500);
+    BOOST_CHECK_EQUAL(remoteResult->type(), ExecutionMessage::MESSAGE);
+    BOOST_CHECK_EQUAL(remoteResult->to(), BAddress);
+
+    executor->setMaxLocalCallDepth(8);
+    auto localResult = call(501);
+    BOOST_CHECK_EQUAL(localResult->type(), ExecutionMessage::FINISHED);
+    BOOST_CHECK_EQUAL(localResult->status(), 0);
+    BOOST_CHECK(localResult->data().toBytes() == value);
+}
+
+BOOST_AUTO_TEST_CASE(nestedCallInput)
+{
+    // Grows its memory with mstore(0x10000, 1), then returns calldataload(0)
+    std::string calleeBin =
+        "601280600b6000396000f3"
+        "6001620100005260003560005260206000f3";
+
+    // Calls the address passed in with the 32 bytes pattern as input, returns the output
+    std::string pattern = "0102030405060708091011121314151617181920212223242526272829303132";
+    std::string callerBin = "603780600b6000396000f3"
+                            "7f" +
+                            pattern +
+                            "600052"
+                            "6020600060206000"
+                            "600035"
+                            "5afa"
+                            "50"
+                            "60206000f3";
+
+    auto blockHeader = std::make_shared<bcos::protocol::PBBlockHeader>(cryptoSuite);
+    blockHeader->setNumber(1);
+    std::promise<void> nextPromise;
+    executor->nextBlockHeader(blockHeader, [&](bcos::Error::Ptr&& error) {
+        BOOST_CHECK(!error);
+        nextPromise.set_value();
+    });
+    nextPromise.get_future().get();
+
+    bytes calleeInput;
+    boost::algorithm::unhex(calleeBin, std::back_inserter(calleeInput));
+    auto calleeAddress = deploy(calleeInput, 100, "ee6f30856ad3bae00b1169808488502786a13e3c");
+
+    bytes callerInput;
+    boost::algorithm::unhex(callerBin, std::back_inserter(callerInput));
+    auto callerAddress = deploy(callerInput, 101, "ff6f30856ad3bae00b1169808488502786a13e3c");
+
+    bcos::executor::TransactionExecutor::TwoPCParams commitParams{};
+    commitParams.number = 1;
+    executor->prepare(commitParams, [](bcos::Error::Ptr error) { BOOST_CHECK(!error); });
+    executor->commit(commitParams, [](bcos::Error::Ptr error) { BOOST_CHECK(!error); });
+
+    // The callee runs in this executor, its input is a view of the memory of the caller frame
+    executor->setMaxLocalCallDepth(8);
+
+    bytes data(12, 0);
+    boost::algorithm::unhex(calleeAddress, std::back_inserter(data));
+
+    auto callParam = std::make_unique<NativeExecutionMessage>();
+    callParam->setType(NativeExecutionMessage::MESSAGE);
+    callParam->setContextID(500);
+    callParam->setSeq(1000);
+    callParam->setDepth(0);
+    callParam->setFrom(std::string(callerAddress));
+    callParam->setTo(std::string(callerAddress));
+    callParam->setOrigin(std::string(callerAddress));
+    callParam->setData(std::move(data));
+    callParam->setStaticCall(true);
+    callParam->setGasAvailable(gas);
+    callParam->setCreate(false);
+
+    bcos::protocol::ExecutionMessage::UniquePtr callResult;
+    executor->call(std::move(callParam),
+        [&](bcos::Error::UniquePtr error, ExecutionMessage::UniquePtr response) {
+            BOOST_CHECK(!error);
+            callResult = std::move(response);
+        });
+
+    BOOST_REQUIRE(callResult);
+    BOOST_CHECK_EQUAL(callResult->type(), ExecutionMessage::FINISHED);
+    BOOST_CHECK_EQUAL(callResult->status(), 0);
+    bytes expected;
+    boost::algorithm::unhex(pattern, std::back_inserter(expected));
+    BOOST_CHECK(callResult->data().toBytes() == expected);
+}
+
+BOOST_AUTO_TEST_CASE(readOnlyCall)
+{
+    // Reads slot 0, then returns staticcall(gas(), calldataload(0)) of the address passed in
+    std::string callerBin =
+        "601780600b6000396000f3"
+        "6000545060206000600060006000355afa5060206000f3";
+
+    auto blockHeader = std::make_shared<bcos::protocol::PBBlockHeader>(cryptoSuite);
+    blockHeader->setNumber(1);
+    std::promise<void> nextPromise;
+    executor->nextBlockHeader(blockHeader, [&](bcos::Error::Ptr&& error) {
+        BOOST_CHECK(!error);
+        nextPromise.set_value();
+    });
+    nextPromise.get_future().get();
+
+    bytes helloInput;
+    boost::algorithm::unhex(helloBin, std::back_inserter(helloInput));
+    auto helloAddress = deploy(helloInput, 100, "ee6f30856ad3bae00b1169808488502786a13e3c");
+
+    bytes callerInput;
+    boost::algorithm::unhex(callerBin, std::back_inserter(callerInput));
+    auto callerAddress = deploy(callerInput, 101, "ff6f30856ad3bae00b1169808488502786a13e3c");
+
+    bcos::executor::TransactionExecutor::TwoPCParams commitParams{};
+    commitParams.number = 1;
+    executor->prepare(commitParams, [](bcos::Error::Ptr error) { BOOST_CHECK(!error); });
+    executor->commit(commitParams, [](bcos::Error::Ptr error) { BOOST_CHECK(!error); });
+
+    auto call = [&](int64_t contextID, const std::string& to, bytes data) {
+        auto callParam = std::make_unique<NativeExecutionMessage>();
+        callParam->setType(NativeExecutionMessage::MESSAGE);
+        callParam->setContextID(contextID);
+        callParam->setSeq(1000);
+        callParam->setDepth(0);
+        callParam->setFrom(std::string(to));
+        callParam->setTo(std::string(to));
+        callParam->setOrigin(std::string(to));
+        callParam->setData(std::move(data));
+        callParam->setStaticCall(true);
+        callParam->setGasAvailable(gas);
+        callParam->setCreate(false);
+
+        bcos::protocol::ExecutionMessage::UniquePtr callResult;
+        executor->call(std::move(callParam),
+            [&](bcos::Error::UniquePtr error, ExecutionMessage::UniquePtr response) {
+                BOOST_CHECK(!error);
+                callResult = std::move(response);
+            });
+        return callResult;
+    };
+
+    // set("fisco") writes the storage, it reverts in a call and writes nothing
+    bytes setInput;
+    std::string setHex =
+        "4ed3885e"
+        "0000000000000000000000000000000000000000000000000000000000000020"
+        "0000000000000000000000000000000000000000000000000000000000000005"
+        "666973636f000000000000000000000000000000000000000000000000000000";
+    boost::algorithm::unhex(setHex, std::back_inserter(setInput));
+    auto setResult = call(500, helloAddress, std::move(setInput));
+    BOOST_CHECK_EQUAL(setResult->type(), ExecutionMessage::REVERT);
+    BOOST_CHECK_NE(setResult->status(), 0);
+    BOOST_CHECK_NE(setResult->message().find("read-only"), std::string::npos);
+
+    bytes getInput;
+    boost::algorithm::unhex(std::string("6d4ce63c"), std::back_inserter(getInput));
+    auto getResult = call(501, helloAddress, std::move(getInput));
+    BOOST_CHECK_EQUAL(getResult->type(), ExecutionMessage::FINISHED);
+    BOOST_CHECK_EQUAL(getResult->status(), 0);
+    std::string output;
+    boost::algorithm::hex_lower(
+        getResult->data().begin(), getResult->data().end(), std::back_inserter(output));
+    BOOST_CHECK_EQUAL(output, std::string(62, '0') + "20" + std::string(62, '0') + "0d" +
+                                  "48656c6c6f2c20576f726c6421" + std::string(38, '0'));
+
+    // The reads of the caller take no key lock, the nested call goes to the scheduler without any
+    bytes callerData(12, 0);
+    boost::algorithm::unhex(helloAddress, std::back_inserter(callerData));
+    auto callerResult = call(502, callerAddress, std::move(callerData));
+    BOOST_CHECK_EQUAL(callerResult->type(), ExecutionMessage::MESSAGE);
+    BOOST_CHECK_EQUAL(callerResult->to(), helloAddress);
+    BOOST_CHECK(callerResult->keyLocks().empty());
+}
+
+BOOST_AUTO_TEST_CASE(callResultCacheFlush)
+{
+    executor->setCallResultCacheCapacity(1024 * 1024);
+    auto& callResultCache = executor->callResultCache();
+
+    auto nextBlock = [&](int64_t number) {
+        auto blockHeader = std::make_shared<bcos::protocol::PBBlockHeader>(cryptoSuite);
+        blockHeader->setNumber(number);
+        std::promise<void> nextPromise;
+        executor->nextBlockHeader(blockHeader, [&](bcos::Error::Ptr&& error) {
+            BOOST_CHECK(!error);
+            nextPromise.set_value();
+        });
+        nextPromise.get_future().get();
+    };
+    auto commit = [&](int64_t number) {
+        bcos::executor::TransactionExecutor::TwoPCParams commitParams{};
+        commitParams.number = number;
+        executor->prepare(commitParams, [](bcos::Error::Ptr error) { BOOST_CHECK(!error); });
+        executor->commit(commitParams, [](bcos::Error::Ptr error) { BOOST_CHECK(!error); });
+    };
+
+    nextBlock(1);
+    bytes input;
+    boost::algorithm::unhex(helloBin, std::back_inserter(input));
+    auto tx = fakeTransaction(cryptoSuite, keyPair, "", input, 100, 100001, "1", "1");
+    auto sender = *toHexString(string_view((char*)tx->sender().data(), tx->sender().size()));
+    txpool->hash2Transaction.emplace(tx->hash(), tx);
+
+    auto params = std::make_unique<NativeExecutionMessage>();
+    params->setContextID(100);
+    params->setSeq(1000);
+    params->setDepth(0);
+    params->setOrigin(sender);
+    params->setFrom(sender);
+    params->setTo("ee6f30856ad3bae00b1169808488502786a13e3c");
+    params->setStaticCall(false);
+    params->setGasAvailable(gas);
+    params->setType(NativeExecutionMessage::TXHASH);
+    params->setTransactionHash(tx->hash());
+    params->setCreate(true);
+
+    std::promise<ExecutionMessage::UniquePtr> deployPromise;
+    executor->executeTransaction(std::move(params),
+        [&](bcos::Error::UniquePtr&& error, ExecutionMessage::UniquePtr&& result) {
+            BOOST_CHECK(!error);
+            deployPromise.set_value(std::move(result));
+        });
+    auto deployResult = deployPromise.get_future().get();
+    BOOST_CHECK_EQUAL(deployResult->status(), 0);
+    auto address = std::string(deployResult->newEVMContractAddress());
+    commit(1);
+
+    // get() of helloworld, hex encoded
+    auto get = [&](int64_t contextID) {
+        bytes getInput;
+        boost::algorithm::unhex(std::string("6d4ce63c"), std::back_inserter(getInput));
+
+        auto callParam = std::make_unique<NativeExecutionMessage>();
+        callParam->setType(NativeExecutionMessage::MESSAGE);
+        callParam->setContextID(contextID);
+        callParam->setSeq(1000);
+        callParam->setDepth(0);
+        callParam->setFrom(sender);
+        callParam->setTo(address);
+        callParam->setOrigin(sender);
+        callParam->setData(std::move(getInput));
+        callParam->setStaticCall(true);
+        callParam->setGasAvailable(gas);
+        callParam->setCreate(false);
+
+        bcos::protocol::ExecutionMessage::UniquePtr callResult;
+        executor->call(std::move(callParam),
+            [&](bcos::Error::UniquePtr error, ExecutionMessage::UniquePtr response) {
+                BOOST_CHECK(!error);
+                callResult = std::move(response);
+            });
+        BOOST_CHECK_EQUAL(callResult->type(), ExecutionMessage::FINISHED);
+        BOOST_CHECK_EQUAL(callResult->status(), 0);
+        BOOST_CHECK_EQUAL(callResult->contextID(), contextID);
+
+        std::string output;
+        boost::algorithm::hex_lower(
+            callResult->data().begin(), callResult->data().end(), std::back_inserter(output));
+        return output;
+    };
+    auto helloOutput = std::string(62, '0') + "20" + std::string(62, '0') + "0d" +
+                       "48656c6c6f2c20576f726c6421" + std::string(38, '0');
+    auto fiscoOutput = std::string(62, '0') + "20" + std::string(62, '0') + "05" +
+                       "666973636f" + std::string(54, '0');
+
+    BOOST_CHECK_EQUAL(get(500), helloOutput);
+    BOOST_CHECK_EQUAL(get(501), helloOutput);
+    BOOST_CHECK_EQUAL(callResultCache->misses(), 1);
+    BOOST_CHECK_EQUAL(callResultCache->hits(), 1);
+
+    // set("fisco") in block 2
+    nextBlock(2);
+    bytes setInput;
+    std::string setHex =
+        "4ed3885e"
+        "0000000000000000000000000000000000000000000000000000000000000020"
+        "0000000000000000000000000000000000000000000000000000000000000005"
+        "666973636f000000000000000000000000000000000000000000000000000000";
+    boost::algorithm::unhex(setHex, std::back_inserter(setInput));
+    auto setParams = std::make_unique<NativeExecutionMessage>();
+    setParams->setContextID(101);
+    setParams->setSeq(1000);
+    setParams->setDepth(0);
+    setParams->setFrom(sender);
+    setParams->setTo(address);
+    setParams->setOrigin(sender);
+    setParams->setStaticCall(false);
+    setParams->setGasAvailable(gas);
+    setParams->setData(std::move(setInput));
+    setParams->setType(NativeExecutionMessage::MESSAGE);
+
+    std::promise<ExecutionMessage::UniquePtr> setPromise;
+    executor->executeTransaction(std::move(setParams),
+        [&](bcos::Error::UniquePtr&& error, ExecutionMessage::UniquePtr&& result) {
+            BOOST_CHECK(!error);
+            setPromise.set_value(std::move(result));
+        });
+    BOOST_CHECK_EQUAL(setPromise.get_future().get()->status(), 0);
+
+    // Calls read the committed state, block 2 isn't committed yet
+    BOOST_CHECK_EQUAL(get(502), helloOutput);
+    BOOST_CHECK_EQUAL(callResultCache->hits(), 2);
+
+    // The commit flushes the cache, the call runs again on the new state
+    commit(2);
+    BOOST_CHECK_EQUAL(callResultCache->number(), 2);
+    BOOST_CHECK_EQUAL(get(503), fiscoOutput);
+    BOOST_CHECK_EQUAL(callResultCache->misses(), 2);
+    BOOST_CHECK_EQUAL(get(504), fiscoOutput);
+    BOOST_CHECK_EQUAL(callResultCache->hits(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(extCodeSizeAndHash)
+{
+    // Returns extcodesize and extcodehash of the address passed in
+    std::string runtimeBin = "600035803b6000523f60205260406000f3";
+    std::string proberBin = "601180600b6000396000f3" + runtimeBin;
+
+    auto blockHeader = std::make_shared<bcos::protocol::PBBlockHeader>(cryptoSuite);
+    blockHeader->setNumber(1);
+    std::promise<void> nextPromise;
+    executor->nextBlockHeader(blockHeader, [&](bcos::Error::Ptr&& error) {
+        BOOST_CHECK(!error);
+        nextPromise.set_value();
+    });
+    nextPromise.get_future().get();
+
+    bytes proberInput;
+    boost::algorithm::unhex(proberBin, std::back_inserter(proberInput));
+    auto proberAddress = deploy(proberInput, 100, "ee6f30856ad3bae00b1169808488502786a13e3c");
+    auto targetAddress = deploy(proberInput, 101, "ff6f30856ad3bae00b1169808488502786a13e3c");
+
+    bcos::executor::TransactionExecutor::TwoPCParams commitParams{};
+    commitParams.number = 1;
+    executor->prepare(commitParams, [](bcos::Error::Ptr error) { BOOST_CHECK(!error); });
+    executor->commit(commitParams, [](bcos::Error::Ptr error) { BOOST_CHECK(!error); });
+
+    auto probe = [&](int64_t contextID, const std::string& address) {
+        bytes data(12, 0);
+        boost::algorithm::unhex(address, std::back_inserter(data));
+
+        auto callParam = std::make_unique<NativeExecutionMessage>();
+        callParam->setType(NativeExecutionMessage::MESSAGE);
+        callParam->setContextID(contextID);
+        callParam->setSeq(1000);
+        callParam->setDepth(0);
+        callParam->setFrom(std::string(proberAddress));
+        callParam->setTo(std::string(proberAddress));
+        callParam->setOrigin(std::string(proberAddress));
+        callParam->setData(std::move(data));
+        callParam->setStaticCall(true);
+        callParam->setGasAvailable(gas);
+        callParam->setCreate(false);
+
+        bcos::protocol::ExecutionMessage::UniquePtr callResult;
+        executor->call(std::move(callParam),
+            [&](bcos::Error::UniquePtr error, ExecutionMessage::UniquePtr response) {
+                BOOST_CHECK(!error);
+                callResult = std::move(response);
+            });
+        BOOST_CHECK_EQUAL(callResult->type(), ExecutionMessage::FINISHED);
+        BOOST_CHECK_EQUAL(callResult->status(), 0);
+
+        auto output = callResult->data();
+        BOOST_CHECK_EQUAL(output.size(), 64);
+        return std::make_tuple(fromBigEndian<u256>(output.getCroppedData(0, 32)),
+            h256(output.getCroppedData(32, 32)));
+    };
+
+    bytes runtime;
+    boost::algorithm::unhex(runtimeBin, std::back_inserter(runtime));
+    auto runtimeHash = hashImpl->hash(runtime);
+
+    auto [size, codeHash] = probe(500, targetAddress);
+    BOOST_CHECK_EQUAL(size, runtime.size());
+    BOOST_CHECK(codeHash == runtimeHash);
+
+    // Precompiled contracts have no code row but are not empty
+    std::tie(size, codeHash) = probe(501, "0000000000000000000000000000000000000002");
+    BOOST_CHECK_EQUAL(size, 1);
+    BOOST_CHECK(codeHash == h256());
+
+    // No contract at the address
+    std::tie(size, codeHash) = probe(502, "1234567890123456789012345678901234567890");
+    BOOST_CHECK_EQUAL(size, 0);
+    BOOST_CHECK(codeHash == h256());
+
+    // The size doesn't depend on the code cache
+    executor->setCodeCacheCapacity(0);
+    std::tie(size, codeHash) = probe(503, targetAddress);
+    BOOST_CHECK_EQUAL(size, runtime.size());
+    BOOST_CHECK(codeHash == runtimeHash);
+}
+
+BOOST_AUTO_TEST_CASE(blockHash)
+{
+    // Returns blockhash(calldataload(0))
+    std::string blockHashBin = "600c80600b6000396000f3"
+                               "6000354060005260206000f3";
+
+    auto hashOf = [this](int64_t number) {
+        auto data = std::to_string(number);
+        return hashImpl->hash(bytesConstRef((const byte*)data.data(), data.size()));
+    };
+    auto nextBlock = [&](int64_t number) {
+        auto blockHeader = std::make_shared<bcos::protocol::PBBlockHeader>(cryptoSuite);
+        blockHeader->setNumber(number);
+        blockHeader->setParentInfo({bcos::protocol::ParentInfo{number - 1, hashOf(number - 1)}});
+        std::promise<void> nextPromise;
+        executor->nextBlockHeader(blockHeader, [&](bcos::Error::Ptr&& error) {
+            BOOST_CHECK(!error);
+            nextPromise.set_value();
+        });
+        nextPromise.get_future().get();
+    };
+
+    nextBlock(1);
+    bytes input;
+    boost::algorithm::unhex(blockHashBin, std::back_inserter(input));
+    auto address = deploy(input, 100, "ee6f30856ad3bae00b1169808488502786a13e3c");
+
+    // BLOCKHASH of number in a transaction of the current block
+    auto blockHashAt = [&](int64_t contextID, int64_t number) {
+        auto callParams = std::make_unique<NativeExecutionMessage>();
+        callParams->setContextID(contextID);
+        callParams->setSeq(1000);
+        callParams->setDepth(0);
+        callParams->setFrom(address);
+        callParams->setTo(address);
+        callParams->setOrigin(address);
+        callParams->setStaticCall(false);
+        callParams->setGasAvailable(gas);
+        callParams->setData(codec->encode(s256(number)));
+        callParams->setType(NativeExecutionMessage::MESSAGE);
+
+        std::promise<ExecutionMessage::UniquePtr> executePromise;
+        executor->executeTransaction(std::move(callParams),
+            [&](bcos::Error::UniquePtr&& error, ExecutionMessage::UniquePtr&& result) {
+                BOOST_CHECK(!error);
+                executePromise.set_value(std::move(result));
+            });
+        auto result = executePromise.get_future().get();
+        BOOST_CHECK_EQUAL(result->status(), 0);
+        BOOST_CHECK_EQUAL(result->data().size(), 32);
+        return h256(result->data());
+    };
+
+    BOOST_CHECK(blockHashAt(101, 0) == hashOf(0));
+    BOOST_CHECK(blockHashAt(102, 1) == h256());
+    BOOST_CHECK(blockHashAt(103, 2) == h256());
+
+    // The parent of the next block is added, the older hashes are kept
+    nextBlock(2);
+    BOOST_CHECK(blockHashAt(104, 1) == hashOf(1));
+    BOOST_CHECK(blockHashAt(105, 0) == hashOf(0));
+    BOOST_CHECK(blockHashAt(106, 2) == h256());
+}
+
+BOOST_AUTO_TEST_CASE(uncommittedCapacity)
+{
+    auto helloworld = string(helloBin);
+
+    bytes input;
+    boost::algorithm::unhex(helloworld, std::back_inserter(input));
+    auto tx = fakeTransaction(cryptoSuite, keyPair, "", input, 101, 100001, "1", "1");
+    auto hash = tx->hash();
+    txpool->hash2Transaction.emplace(hash, tx);
+
+    executor->setMaxUncommittedCapacity(1);
+    BOOST_CHECK_EQUAL(executor->maxUncommittedCapacity(), 1);
+
+    auto blockHeader = std::make_shared<bcos::protocol::PBBlockHeader>(cryptoSuite);
+    blockHeader->setNumber(1);
+
+    std::promise<void> nextPromise;
+    executor->nextBlockHeader(blockHeader, [&](bcos::Error::Ptr&& error) {
+        BOOST_CHECK(!error);
+        nextPromise.set_value();
+    });
+    nextPromise.get_future().get();
+
+    auto params = std::make_unique<NativeExecutionMessage>();
+    params->setType(bcos::protocol::ExecutionMessage::TXHASH);
+    params->setContextID(100);
+    params->setSeq(1000);
+    params->setDepth(0);
+    h256 addressCreate("ff6f30856ad3bae00b1169808488502786a13e3c174d85682135ffd51310310e");
+    params->setTo(addressCreate.hex().substr(0, 40));
+    params->setStaticCall(false);
+    params->setGasAvailable(gas);
+    params->setTransactionHash(hash);
+    params->setCreate(true);
+
+    std::promise<bcos::protocol::ExecutionMessage::UniquePtr> executePromise;
+    executor->executeTransaction(std::move(params),
+        [&](bcos::Error::UniquePtr&& error, bcos::protocol::ExecutionMessage::UniquePtr&& result) {
+            BOOST_CHECK(!error);
+            executePromise.set_value(std::move(result));
+        });
+    auto result = executePromise.get_future().get();
+    BOOST_CHECK_EQUAL(result->status(), 0);
+    BOOST_CHECK_GT(executor->uncommittedCapacity(), 0);
+    BOOST_CHECK_EQUAL(executor->uncommittedBlocks(), 1);
+
+    // block 1 is not committed, the budget is exceeded
+    auto blockHeader2 = std::make_shared<bcos::protocol::PBBlockHeader>(cryptoSuite);
+    blockHeader2->setNumber(2);
+
+    std::promise<void> nextPromise2;
+    executor->nextBlockHeader(blockHeader2, [&](bcos::Error::Ptr&& error) {
+        BOOST_CHECK(error);
+        BOOST_CHECK_EQUAL(error->errorCode(), ExecuteError::STATE_CAPACITY_EXCEEDED);
+        nextPromise2.set_value();
+    });
+    nextPromise2.get_future().get();
+
+    // commit block 1 to release the budget
+    bcos::executor::TransactionExecutor::TwoPCParams commitParams{};
+    commitParams.number = 1;
+
+    std::promise<void> preparePromise;
+    executor->prepare(commitParams, [&](bcos::Error::Ptr&& error) {
+        BOOST_CHECK(!error);
+        preparePromise.set_value();
+    });
+    preparePromise.get_future().get();
+
+    std::promise<void> commitPromise;
+    executor->commit(commitParams, [&](bcos::Error::Ptr&& error) {
+        BOOST_CHECK(!error);
+        commitPromise.set_value();
+    });
+    commitPromise.get_future().get();
+    BOOST_CHECK_EQUAL(executor->uncommittedCapacity(), 0);
+    BOOST_CHECK_EQUAL(executor->uncommittedBlocks(), 0);
+
+    std::promise<void> nextPromise3;
+    executor->nextBlockHeader(blockHeader2, [&](bcos::Error::Ptr&& error) {
+        BOOST_CHECK(!error);
+        nextPromise3.set_value();
+    });
+    nextPromise3.get_future().get();
+    BOOST_CHECK_EQUAL(executor->uncommittedBlocks(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(nestedFrameLogs)
+{
+    // Emits log1(0, 32, 1) with 0xab in memory, then stops, or reverts if called with any input
+    std::string logBin =
+        "601880600b6000396000f3"
+        "60ab600052"
+        "600160206000a1"
+        "3615601657"
+        "60006000fd"
+        "5b00";
+
+    auto blockHeader = std::make_shared<bcos::protocol::PBBlockHeader>(cryptoSuite);
+    blockHeader->setNumber(1);
+    std::promise<void> nextPromise;
+    executor->nextBlockHeader(blockHeader, [&](bcos::Error::Ptr&& error) {
+        BOOST_CHECK(!error);
+        nextPromise.set_value();
+    });
+    nextPromise.get_future().get();
+
+    bytes input;
+    boost::algorithm::unhex(logBin, std::back_inserter(input));
+    auto address = deploy(input, 100, "ff6f30856ad3bae00b1169808488502786a13e3c");
+
+    std::string sender = "e0e0e0e0e0e0e0e0e0e0e0e0e0e0e0e0e0e0e0e0";
+    auto execute = [&](int64_t contextID, const std::string& from, bytes data) {
+        auto params = std::make_unique<NativeExecutionMessage>();
+        params->setType(NativeExecutionMessage::MESSAGE);
+        params->setContextID(contextID);
+        params->setSeq(1000);
+        params->setDepth(0);
+        params->setFrom(std::string(from));
+        params->setTo(std::string(address));
+        params->setOrigin(std::string(sender));
+        params->setData(std::move(data));
+        params->setStaticCall(false);
+        params->setGasAvailable(gas);
+        params->setCreate(false);
+
+        std::promise<ExecutionMessage::UniquePtr> executePromise;
+        executor->executeTransaction(std::move(params),
+            [&](bcos::Error::UniquePtr&& error, ExecutionMessage::UniquePtr&& result) {
+                BOOST_CHECK(!error);
+                executePromise.set_value(std::move(result));
+            });
+        return executePromise.get_future().get();
+    };
+
+    // The top level frame keeps its log
+    auto result = execute(101, sender, bytes());
+    BOOST_CHECK_EQUAL(result->type(), ExecutionMessage::FINISHED);
+    BOOST_CHECK_EQUAL(result->status(), 0);
+    BOOST_REQUIRE_EQUAL(result->logEntries().size(), 1);
+    auto& logEntry = result->logEntries()[0];
+    BOOST_CHECK_EQUAL(logEntry.address(), address);
+    BOOST_REQUIRE_EQUAL(logEntry.topics().size(), 1);
+    BOOST_CHECK(logEntry.topics()[0] == h256(1));
+    BOOST_REQUIRE_EQUAL(logEntry.data().size(), 32);
+    BOOST_CHECK_EQUAL(logEntry.data()[31], 0xab);
+
+    // A nested frame, called by another contract, has no log
+    result = execute(102, "ee6f30856ad3bae00b1169808488502786a13e3c", bytes());
+    BOOST_CHECK_EQUAL(result->type(), ExecutionMessage::FINISHED);
+    BOOST_CHECK_EQUAL(result->status(), 0);
+    BOOST_CHECK(result->logEntries().empty());
+
+    // Neither has a reverted frame
+    result = execute(103, sender, bytes{1});
+    BOOST_CHECK_EQUAL(result->type(), ExecutionMessage::REVERT);
+    BOOST_CHECK(result->logEntries().empty());
+}
+
+BOOST_AUTO_TEST_CASE(responseToFinishedExecutive)
+{
+    bytes input;
+    boost::algorithm::unhex(helloBin, std::back_inserter(input));
+    auto tx = fakeTransaction(cryptoSuite, keyPair, "", input, 101, 100001, "1", "1");
+    auto hash = tx->hash();
+    txpool->hash2Transaction.emplace(hash, tx);
+
+    auto blockHeader = std::make_shared<bcos::protocol::PBBlockHeader>(cryptoSuite);
+    blockHeader->setNumber(1);
+
+    std::promise<void> nextPromise;
+    executor->nextBlockHeader(blockHeader, [&](bcos::Error::Ptr&& error) {
+        BOOST_CHECK(!error);
+        nextPromise.set_value();
+    });
+    nextPromise.get_future().get();
+
+    auto params = std::make_unique<NativeExecutionMessage>();
+    params->setType(bcos::protocol::ExecutionMessage::TXHASH);
+    params->setContextID(100);
+    params->setSeq(1000);
+    params->setDepth(0);
+    h256 addressCreate("ff6f30856ad3bae00b1169808488502786a13e3c174d85682135ffd51310310e");
+    params->setTo(addressCreate.hex().substr(0, 40));
+    params->setStaticCall(false);
+    params->setGasAvailable(gas);
+    params->setTransactionHash(hash);
+    params->setCreate(true);
+
+    std::promise<bcos::protocol::ExecutionMessage::UniquePtr> executePromise;
+    executor->executeTransaction(std::move(params),
+        [&](bcos::Error::UniquePtr&& error, bcos::protocol::ExecutionMessage::UniquePtr&& result) {
+            BOOST_CHECK(!error);
+            executePromise.set_value(std::move(result));
+        });
+    auto result = executePromise.get_future().get();
+    BOOST_CHECK_EQUAL(result->type(), ExecutionMessage::FINISHED);
+    BOOST_CHECK_EQUAL(result->status(), 0);
+
+    // The executive of (100, 1000) is erased once finished, a late response must not start a new
+    // one
+    for (auto type : {ExecutionMessage::FINISHED, ExecutionMessage::REVERT})
+    {
+        auto response = std::make_unique<NativeExecutionMessage>();
+        response->setType(type);
+        response->setContextID(100);
+        response->setSeq(1000);
+        response->setDepth(0);
+        response->setFrom(std::string(result->newEVMContractAddress()));
+        response->setTo(std::string(result->newEVMContractAddress()));
+        response->setStaticCall(false);
+        response->setGasAvailable(gas);
+        response->setCreate(false);
+
+        std::promise<void> responsePromise;
+        executor->executeTransaction(std::move(response),
+            [&](bcos::Error::UniquePtr&& error, ExecutionMessage::UniquePtr&& output) {
+                BOOST_CHECK(error);
+                BOOST_CHECK_EQUAL(error->errorCode(), ExecuteError::EXECUTE_ERROR);
+                BOOST_CHECK(!output);
+                responsePromise.set_value();
+            });
+        responsePromise.get_future().get();
+    }
+}
+
 BOOST_AUTO_TEST_CASE(deployErrorCode)
 {
     // an infinity-loop constructor
@@ -0,0 +1,105 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+/**
+ * @brief : unitest for the table qualified key lock set
+ */
+
+#include "../src/executive/KeyLocks.h"
+#include <boost/test/unit_test.hpp>
+#include <set>
+#include <string>
+
+using namespace std;
+using namespace bcos;
+using namespace bcos::executor;
+
+namespace bcos
+{
+namespace test
+{
+struct KeyLocksFixture
+{
+    KeyLockSet keyLocks;
+    uint64_t tableA = hashTableName("/apps/0xa");
+    uint64_t tableB = hashTableName("/apps/0xb");
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestKeyLocks, KeyLocksFixture)
+
+BOOST_AUTO_TEST_CASE(QualifiedByTable)
+{
+    BOOST_CHECK_NE(tableA, tableB);
+    BOOST_CHECK(keyLocks.insert(tableA, "code"));
+    BOOST_CHECK(!keyLocks.insert(tableA, "code"));
+    BOOST_CHECK(keyLocks.contains(tableA, "code"));
+
+    // The same key of another table isn't a conflict
+    BOOST_CHECK(!keyLocks.contains(tableB, "code"));
+    BOOST_CHECK(!keyLocks.contains(tableA, "cod"));
+    BOOST_CHECK(keyLocks.insert(tableB, "code"));
+    BOOST_CHECK_EQUAL(keyLocks.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(EncodeAndDecode)
+{
+    // Binary keys, e.g. evm storage slots
+    std::string slot(32, 0);
+    auto keyLock = KeyLockSet::encode("/apps/0xa", slot);
+    BOOST_CHECK_EQUAL(keyLock.size(), KeyLockSet::c_tableHashSize + slot.size());
+    BOOST_CHECK(keyLock == KeyLockSet::encode(tableA, slot));
+
+    uint64_t tableHash = 0;
+    std::string_view key;
+    BOOST_CHECK(KeyLockSet::decode(keyLock, tableHash, key));
+    BOOST_CHECK_EQUAL(tableHash, tableA);
+    BOOST_CHECK(key == slot);
+
+    BOOST_CHECK(!KeyLockSet::decode("code", tableHash, key));
+    BOOST_CHECK(!keyLocks.insertEncoded("code"));
+    BOOST_CHECK(keyLocks.insertEncoded(keyLock));
+    BOOST_CHECK(keyLocks.contains(tableA, slot));
+}
+
+BOOST_AUTO_TEST_CASE(ExportAndGrow)
+{
+    std::set<std::string> expected;
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto key = "key" + std::to_string(i);
+        keyLocks.insert(i % 2 ? tableA : tableB, key);
+        expected.insert(KeyLockSet::encode(i % 2 ? tableA : tableB, key));
+    }
+    BOOST_CHECK_EQUAL(keyLocks.size(), 1000);
+    BOOST_CHECK(keyLocks.contains(tableA, "key999"));
+    BOOST_CHECK(!keyLocks.contains(tableB, "key999"));
+
+    auto exported = keyLocks.exportEncoded();
+    BOOST_CHECK(std::set<std::string>(exported.begin(), exported.end()) == expected);
+    BOOST_CHECK(keyLocks.empty());
+    BOOST_CHECK(!keyLocks.contains(tableA, "key999"));
+
+    KeyLockSet imported;
+    for (auto& it : exported)
+    {
+        BOOST_CHECK(imported.insertEncoded(it));
+    }
+    BOOST_CHECK(imported.contains(tableA, "key999"));
+    BOOST_CHECK_EQUAL(imported.size(), 1000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
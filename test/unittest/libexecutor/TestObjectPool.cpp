@@ -0,0 +1,147 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+/**
+ * @brief : unitest and benchmark of the thread local block pool
+ */
+
+#include "../src/CallParameters.h"
+#include "../src/executive/ObjectPool.h"
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace bcos;
+using namespace bcos::executor;
+
+namespace bcos
+{
+namespace test
+{
+namespace
+{
+// Skips the pool of CallParameters, as an allocation without it
+struct GlobalDelete
+{
+    void operator()(CallParameters* ptr) const
+    {
+        ptr->~CallParameters();
+        ::operator delete(ptr);
+    }
+};
+}  // namespace
+
+struct ObjectPoolFixture
+{
+    using Pool = ThreadLocalBlockPool<64, 4>;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestObjectPool, ObjectPoolFixture)
+
+BOOST_AUTO_TEST_CASE(RecycleBlock)
+{
+    BOOST_CHECK_EQUAL(Pool::cachedBlocks(), 0);
+
+    auto block = Pool::allocate();
+    Pool::deallocate(block);
+    BOOST_CHECK_EQUAL(Pool::cachedBlocks(), 1);
+
+    BOOST_CHECK_EQUAL(Pool::allocate(), block);
+    BOOST_CHECK_EQUAL(Pool::cachedBlocks(), 0);
+    Pool::deallocate(block);
+
+    // At most 4 blocks are cached, the others are released
+    std::vector<void*> blocks;
+    for (int i = 0; i < 8; ++i)
+    {
+        blocks.push_back(Pool::allocate());
+    }
+    for (auto it : blocks)
+    {
+        Pool::deallocate(it);
+    }
+    BOOST_CHECK_EQUAL(Pool::cachedBlocks(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(FreeByAnotherThread)
+{
+    std::vector<void*> blocks;
+    for (int i = 0; i < 4; ++i)
+    {
+        blocks.push_back(Pool::allocate());
+    }
+
+    size_t cached = 0;
+    std::thread thread([&]() {
+        for (auto it : blocks)
+        {
+            Pool::deallocate(it);
+        }
+        cached = Pool::cachedBlocks();
+    });
+    thread.join();
+
+    // The blocks were cached by the other thread, and released as it exited
+    BOOST_CHECK_EQUAL(cached, 4);
+}
+
+BOOST_AUTO_TEST_CASE(CallParametersPerformance)
+{
+    // Every transaction creates and destroys a few messages, some of them live across a batch
+    size_t batches = 20000;
+    size_t batchSize = 64;
+    std::string address(40, 'a');
+
+    auto run = [&](auto create) {
+        std::vector<decltype(create())> messages;
+        messages.reserve(batchSize);
+        auto start = chrono::system_clock::now();
+        for (size_t i = 0; i < batches; ++i)
+        {
+            for (size_t j = 0; j < batchSize; ++j)
+            {
+                auto message = create();
+                message->contextID = i;
+                message->seq = j;
+                messages.emplace_back(std::move(message));
+            }
+            messages.clear();
+        }
+        auto end = chrono::system_clock::now();
+        return chrono::duration_cast<chrono::microseconds>(end - start).count();
+    };
+
+    auto plain = run([]() {
+        return std::unique_ptr<CallParameters, GlobalDelete>(
+            ::new (::operator new(sizeof(CallParameters))) CallParameters(CallParameters::MESSAGE));
+    });
+    auto pooled = run([]() { return std::make_unique<CallParameters>(CallParameters::MESSAGE); });
+    cout << "Create " << batches * batchSize << " call parameters, time used(us) plain=" << plain
+         << " pooled=" << pooled << endl;
+
+    // The last batch is cached for the next one
+    BOOST_CHECK_GE(CallParametersPool::cachedBlocks(), batchSize);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,96 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+/**
+ * @brief : unitest of the per transaction storage read cache
+ */
+
+#include "../src/executive/StorageReadCache.h"
+#include <boost/test/unit_test.hpp>
+#include <optional>
+#include <string>
+
+using namespace std;
+using namespace bcos;
+using namespace bcos::executor;
+
+namespace bcos
+{
+namespace test
+{
+struct StorageReadCacheFixture
+{
+    StorageReadCache<std::optional<std::string>> cache{64};
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestStorageReadCache, StorageReadCacheFixture)
+
+BOOST_AUTO_TEST_CASE(FindAndInsert)
+{
+    BOOST_CHECK(!cache.find(0, "balance"));
+
+    // A missing row is cached as well
+    cache.insert(0, "balance", std::nullopt);
+    auto cached = cache.find(0, "balance");
+    BOOST_CHECK(cached && !*cached);
+
+    cache.insert(0, "balance", std::string("100"));
+    cached = cache.find(0, "balance");
+    BOOST_CHECK(cached && *cached == "100");
+    BOOST_CHECK_EQUAL(cache.size(), 1);
+
+    // Same key in another table
+    BOOST_CHECK(!cache.find(1, "balance"));
+    cache.insert(1, "balance", std::string("200"));
+    BOOST_CHECK(*cache.find(0, "balance") == "100");
+    BOOST_CHECK(*cache.find(1, "balance") == "200");
+    BOOST_CHECK_EQUAL(cache.size(), 2);
+
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.size(), 0);
+    BOOST_CHECK(!cache.find(0, "balance"));
+    BOOST_CHECK(!cache.find(1, "balance"));
+}
+
+BOOST_AUTO_TEST_CASE(GrowAndClearWhenFull)
+{
+    BOOST_CHECK_EQUAL(cache.slots(), StorageReadCache<int>::c_initialSlots);
+    for (int i = 0; i < 64; ++i)
+    {
+        cache.insert(0, "key" + std::to_string(i), std::to_string(i));
+    }
+    BOOST_CHECK_EQUAL(cache.size(), 64);
+    BOOST_CHECK_GE(cache.slots(), 64);
+    for (int i = 0; i < 64; ++i)
+    {
+        auto cached = cache.find(0, "key" + std::to_string(i));
+        BOOST_REQUIRE(cached);
+        BOOST_CHECK(*cached == std::to_string(i));
+    }
+
+    // Full at the max size, start over instead of growing
+    auto slots = cache.slots();
+    for (int i = 64; i < 256; ++i)
+    {
+        cache.insert(0, "key" + std::to_string(i), std::to_string(i));
+    }
+    BOOST_CHECK_EQUAL(cache.slots(), slots);
+    BOOST_CHECK_LT(cache.size(), 128);
+    BOOST_CHECK(*cache.find(0, "key255") == "255");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
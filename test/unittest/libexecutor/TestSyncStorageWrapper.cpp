@@ -0,0 +1,279 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+/**
+ * @brief : unitest and benchmark for the read cache of the sync storage wrapper
+ */
+
+#include "../src/executive/KeyLocks.h"
+#include "../src/executive/SyncStorageWrapper.h"
+#include "../src/executive/TableNameInterner.h"
+#include "libstorage/StateStorage.h"
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace bcos;
+using namespace bcos::executor;
+using namespace bcos::storage;
+
+namespace bcos
+{
+namespace test
+{
+struct SyncStorageWrapperFixture
+{
+    SyncStorageWrapperFixture()
+    {
+        storage = std::make_shared<StateStorage>(nullptr);
+        recoder = storage->newRecoder();
+        wrapper = std::make_unique<SyncStorageWrapper>(
+            storage, [this](std::string keyLock) { onKeyLockWait(std::move(keyLock)); }, recoder);
+        wrapper->setRecoder(recoder);
+        wrapper->enableReadCache(64);
+
+        wrapper->createTable(std::string(tableName), STORAGE_VALUE);
+        table = interner.intern(tableName);
+    }
+
+    static Entry makeEntry(std::string value)
+    {
+        Entry entry;
+        entry.importFields({std::move(value)});
+        return entry;
+    }
+
+    // The value read through the cache of the wrapper, empty if no row
+    std::string read(const std::string_view& key)
+    {
+        auto entry = wrapper->getRow(table, key);
+        return entry ? std::string(entry->getField(0)) : std::string();
+    }
+
+    // A write to the state storage not going through the wrapper, e.g. by another executive or a
+    // precompiled contract
+    void writeBehind(const std::string_view& key, std::string value)
+    {
+        auto storageTable = storage->openTable(tableName);
+        BOOST_REQUIRE(storageTable);
+        storageTable->setRow(key, makeEntry(std::move(value)));
+    }
+
+    // The predicate of HostContext::exchange, a missing row reads as the empty value
+    static auto isUnchanged(const std::string_view& value)
+    {
+        return [value](const std::optional<Entry>& previous) {
+            return previous ? previous->getField(0) == value : value.empty();
+        };
+    }
+
+    // Number of changes recorded for revert
+    size_t recordedChanges() { return std::distance(recoder->begin(), recoder->end()); }
+
+    std::function<void(std::string)> onKeyLockWait = [](std::string) {};
+
+    const std::string_view tableName = "/apps/cachetest";
+    StateStorage::Ptr storage;
+    StateStorage::Recoder::Ptr recoder;
+    std::unique_ptr<SyncStorageWrapper> wrapper;
+    TableNameInterner interner;
+    InternedTable table;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestSyncStorageWrapper, SyncStorageWrapperFixture)
+
+BOOST_AUTO_TEST_CASE(SetRowByName)
+{
+    BOOST_CHECK_EQUAL(read("balance"), "");
+
+    // The row read through the interned table is cached, the write by name must not leave it
+    // stale
+    wrapper->setRow(tableName, "balance", makeEntry("100"));
+    BOOST_CHECK_EQUAL(read("balance"), "100");
+
+    wrapper->setRow(table, "balance", makeEntry("200"));
+    BOOST_CHECK_EQUAL(read("balance"), "200");
+    wrapper->setRow(tableName, "balance", makeEntry("300"));
+    BOOST_CHECK_EQUAL(read("balance"), "300");
+}
+
+BOOST_AUTO_TEST_CASE(Revert)
+{
+    wrapper->setRow(table, "balance", makeEntry("100"));
+    BOOST_CHECK_EQUAL(read("balance"), "100");
+
+    // As TransactionExecutive::revert does
+    storage->rollback(*recoder);
+    recoder->clear();
+    wrapper->clearReadCache();
+
+    BOOST_CHECK_EQUAL(read("balance"), "");
+    BOOST_CHECK(!storage->openTable(tableName)->getRow("balance"));
+}
+
+BOOST_AUTO_TEST_CASE(ExternalCall)
+{
+    wrapper->setRow(table, "balance", makeEntry("100"));
+    BOOST_CHECK_EQUAL(read("balance"), "100");
+
+    // The callee runs on its own wrapper over the same state storage
+    SyncStorageWrapper callee(storage, [](std::string) {}, storage->newRecoder());
+    callee.setRow(tableName, "balance", makeEntry("200"));
+
+    // As TransactionExecutive::externalCall does when resumed
+    wrapper->setRecoder(recoder);
+    wrapper->clearReadCache();
+
+    BOOST_CHECK_EQUAL(read("balance"), "200");
+}
+
+BOOST_AUTO_TEST_CASE(KeyLockWait)
+{
+    BOOST_CHECK_EQUAL(read("balance"), "");
+
+    // The holder of the lock of "count" writes the rows before releasing it
+    std::vector<std::string> waited;
+    onKeyLockWait = [this, &waited](std::string keyLock) {
+        waited.push_back(std::move(keyLock));
+        writeBehind("balance", "100");
+    };
+    std::vector<std::string> existsKeyLocks{KeyLockSet::encode(tableName, "count")};
+    wrapper->importExistsKeyLocks(existsKeyLocks);
+
+    BOOST_CHECK_EQUAL(read("count"), "");
+    BOOST_REQUIRE_EQUAL(waited.size(), 1);
+    BOOST_CHECK(waited[0] == KeyLockSet::encode(tableName, "count"));
+
+    // The wait dropped the cached rows, without an explicit clear
+    BOOST_CHECK_EQUAL(read("balance"), "100");
+
+    // The lock is held now, no more wait
+    BOOST_CHECK_EQUAL(read("count"), "");
+    BOOST_CHECK_EQUAL(waited.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(PrecompiledCall)
+{
+    wrapper->setRow(table, "balance", makeEntry("100"));
+    BOOST_CHECK_EQUAL(read("balance"), "100");
+
+    // A precompiled contract writes the table directly, then the executive clears the cache as
+    // TransactionExecutive::execPrecompiled does
+    writeBehind("balance", "200");
+    wrapper->clearReadCache();
+
+    BOOST_CHECK_EQUAL(read("balance"), "200");
+}
+
+BOOST_AUTO_TEST_CASE(Exchange)
+{
+    wrapper->setRow(table, "balance", makeEntry("100"));
+
+    auto previous = wrapper->exchange(table, "balance", "200", isUnchanged("200"));
+    BOOST_REQUIRE(previous);
+    BOOST_CHECK_EQUAL(previous->getField(0), "100");
+    BOOST_CHECK_EQUAL(read("balance"), "200");
+    BOOST_CHECK_EQUAL(storage->openTable(tableName)->getRow("balance")->getField(0), "200");
+}
+
+BOOST_AUTO_TEST_CASE(ExchangeUnchanged)
+{
+    wrapper->setRow(table, "balance", makeEntry("100"));
+    auto changes = recordedChanges();
+
+    // Writing the same value records no change
+    auto previous = wrapper->exchange(table, "balance", "100", isUnchanged("100"));
+    BOOST_REQUIRE(previous);
+    BOOST_CHECK_EQUAL(previous->getField(0), "100");
+    BOOST_CHECK_EQUAL(recordedChanges(), changes);
+
+    // Neither does writing the empty value to a missing row, which creates no row
+    previous = wrapper->exchange(table, "missing", "", isUnchanged(""));
+    BOOST_CHECK(!previous);
+    BOOST_CHECK_EQUAL(recordedChanges(), changes);
+    BOOST_CHECK(!storage->openTable(tableName)->getRow("missing"));
+    BOOST_CHECK_EQUAL(read("missing"), "");
+}
+
+BOOST_AUTO_TEST_CASE(ERC20Performance)
+{
+    // Every transfer is checked by balanceOf first, then reads both balances and writes them back
+    // with SSTORE, which reads them again as the old values
+    int accounts = 10000;
+    int transfers = 100000;
+
+    std::vector<std::string> keys;
+    for (int i = 0; i < accounts; ++i)
+    {
+        keys.push_back("balance" + std::to_string(i));
+        writeBehind(keys.back(), "1000000");
+    }
+
+    auto transfer = [&](bool readCache) {
+        // The storage of the block over the state of the previous blocks
+        auto blockStorage = std::make_shared<StateStorage>(storage);
+
+        auto start = chrono::system_clock::now();
+        for (int i = 0; i < transfers; ++i)
+        {
+            // A new executive for every transaction
+            auto recoder = blockStorage->newRecoder();
+            SyncStorageWrapper executive(blockStorage, [](std::string) {}, recoder);
+            executive.setRecoder(recoder);
+            if (readCache)
+            {
+                executive.enableReadCache(64);
+            }
+
+            auto& from = keys[i % accounts];
+            auto& to = keys[(i * 7 + 1) % accounts];
+            executive.getRow(table, from);
+
+            auto fromBalance = std::stoll(std::string(executive.getRow(table, from)->getField(0)));
+            auto toBalance = std::stoll(std::string(executive.getRow(table, to)->getField(0)));
+            auto value = std::to_string(fromBalance - 1);
+            executive.exchange(table, from, value, isUnchanged(value));
+            value = std::to_string(toBalance + 1);
+            executive.exchange(table, to, value, isUnchanged(value));
+        }
+        auto end = chrono::system_clock::now();
+        cout << "ERC20 transfer " << transfers << " times "
+             << (readCache ? "with read cache" : "without read cache") << ", time used(us)="
+             << chrono::duration_cast<chrono::microseconds>(end - start).count() << endl;
+
+        return blockStorage;
+    };
+
+    auto uncached = transfer(false);
+    auto cached = transfer(true);
+
+    // Both end in the same state
+    for (auto& key : keys)
+    {
+        BOOST_CHECK_EQUAL(uncached->openTable(tableName)->getRow(key)->getField(0),
+            cached->openTable(tableName)->getRow(key)->getField(0));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
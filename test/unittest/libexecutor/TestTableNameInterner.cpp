@@ -0,0 +1,82 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+/**
+ * @brief : unitest for the per executive table name interner
+ */
+
+#include "../src/executive/TableNameInterner.h"
+#include <boost/test/unit_test.hpp>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace bcos;
+using namespace bcos::executor;
+
+namespace bcos
+{
+namespace test
+{
+struct TableNameInternerFixture
+{
+    TableNameInterner interner;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestTableNameInterner, TableNameInternerFixture)
+
+BOOST_AUTO_TEST_CASE(InternName)
+{
+    auto first = interner.intern("/apps/0x1234");
+    auto second = interner.intern("/apps/0x5678");
+    BOOST_CHECK_EQUAL(first.id, 0);
+    BOOST_CHECK_EQUAL(second.id, 1);
+    BOOST_CHECK_EQUAL(first.name, "/apps/0x1234");
+    BOOST_CHECK_EQUAL(interner.size(), 2);
+
+    // The name passed in may be a temporary, the interned name is owned by the interner
+    std::string name = "/apps/0x1234";
+    auto again = interner.intern(name);
+    name.clear();
+    BOOST_CHECK_EQUAL(again.id, first.id);
+    BOOST_CHECK_EQUAL(again.name, "/apps/0x1234");
+    BOOST_CHECK_EQUAL(again.name.data(), first.name.data());
+    BOOST_CHECK_EQUAL(interner.name(second.id), "/apps/0x5678");
+    BOOST_CHECK_EQUAL(interner.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(ManyNames)
+{
+    std::vector<InternedTable> tables;
+    for (int j = 0; j < 1000; ++j)
+    {
+        tables.push_back(interner.intern("/apps/" + std::to_string(j)));
+    }
+    BOOST_CHECK_EQUAL(interner.size(), 1000);
+
+    // The names interned first are still valid after the interner grew
+    for (int j = 0; j < 1000; ++j)
+    {
+        BOOST_CHECK_EQUAL(tables[j].id, j);
+        BOOST_CHECK_EQUAL(tables[j].name, "/apps/" + std::to_string(j));
+        BOOST_CHECK_EQUAL(tables[j].hash, hashTableName(tables[j].name));
+        BOOST_CHECK_EQUAL(interner.intern("/apps/" + std::to_string(j)).id, j);
+    }
+    BOOST_CHECK_EQUAL(interner.size(), 1000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
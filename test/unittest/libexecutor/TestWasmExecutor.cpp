@@ -24,6 +24,7 @@
 #include "../liquid/transfer.h"
 #include "../mock/MockTransactionalStorage.h"
 #include "../mock/MockTxPool.h"
+#include "../src/vm/ContractCodeCache.h"
 #include "Common.h"
 #include "bcos-executor/TransactionExecutor.h"
 #include "interfaces/crypto/CommonType.h"
@@ -386,6 +387,13 @@ BOOST_AUTO_TEST_CASE(deployAndCall)
     std::string output;
     codec->decode(result3->data(), output);
     BOOST_CHECK_EQUAL(output, "fisco bcos");
+
+    // The module cached by the deployment is handed to Hera by both calls, never loaded again
+    auto codeCache = executor->codeCache();
+    BOOST_CHECK(codeCache);
+    BOOST_CHECK_EQUAL(codeCache->hits(), 2);
+    BOOST_CHECK_EQUAL(codeCache->misses(), 0);
+    BOOST_CHECK_GT(codeCache->usage(), 0);
 }
 
 
@@ -0,0 +1,87 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+/**
+ * @brief : unitest for the contract code cache
+ */
+
+#include "../../src/vm/ContractCodeCache.h"
+#include <boost/test/unit_test.hpp>
+#include <memory>
+
+using namespace std;
+using namespace bcos;
+using namespace bcos::executor;
+
+namespace bcos::test
+{
+class ContractCodeCacheFixture
+{
+public:
+    ContractCodeCacheFixture()
+    {
+        // 16 shards of 4KB
+        codeCache = make_shared<ContractCodeCache>(64 * 1024);
+    }
+
+    ContractCodeCache::Ptr codeCache;
+};
+
+BOOST_FIXTURE_TEST_SUITE(testContractCodeCache, ContractCodeCacheFixture)
+
+BOOST_AUTO_TEST_CASE(hitAndMiss)
+{
+    h256 codeHash(1);
+    BOOST_CHECK(!codeCache->get(codeHash));
+    BOOST_CHECK_EQUAL(codeCache->misses(), 1);
+
+    auto code = make_shared<const bytes>(bytes{0x00, 0x61, 0x73, 0x6d});
+    codeCache->insert(codeHash, code);
+
+    auto cached = codeCache->get(codeHash);
+    BOOST_CHECK(cached);
+    BOOST_CHECK(*cached == *code);
+    BOOST_CHECK_EQUAL(codeCache->hits(), 1);
+    BOOST_CHECK_GT(codeCache->usage(), code->size());
+
+    BOOST_CHECK(!codeCache->get(h256(2)));
+}
+
+BOOST_AUTO_TEST_CASE(evictByBytes)
+{
+    auto large = make_shared<const bytes>(3 * 1024, 0);
+    h256 codeHash1(1);
+
+    // Larger than the capacity of one shard
+    codeCache->insert(codeHash1, make_shared<const bytes>(5 * 1024, 0));
+    BOOST_CHECK(!codeCache->get(codeHash1));
+
+    codeCache->insert(codeHash1, large);
+    auto code = codeCache->get(codeHash1);
+    BOOST_CHECK(code);
+    BOOST_CHECK_LE(codeCache->usage(), codeCache->capacity());
+
+    // The code held by the caller outlives the eviction
+    for (int i = 0; i < 64; ++i)
+    {
+        codeCache->insert(h256(100 + i), large);
+    }
+    BOOST_CHECK_LE(codeCache->usage(), codeCache->capacity());
+    BOOST_CHECK_EQUAL(code->size(), large->size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace bcos::test
@@ -0,0 +1,171 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+/**
+ * @brief : unitest and benchmark of the thread local vm instance pool
+ */
+
+#include "../../src/executive/BlockContext.h"
+#include "../../src/executive/TransactionExecutive.h"
+#include "../../src/vm/HostContext.h"
+#include "../../src/vm/VMFactory.h"
+#include "../../src/vm/VMInstance.h"
+#include "libstorage/StateStorage.h"
+#include <bcos-framework/testutils/crypto/HashImpl.h>
+#include <evmone/evmone.h>
+#include <boost/algorithm/hex.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace bcos;
+using namespace bcos::executor;
+
+namespace bcos::test
+{
+class VMFactoryFixture
+{
+public:
+    VMFactoryFixture()
+    {
+        hashImpl = std::make_shared<Keccak256Hash>();
+        auto storage = std::make_shared<storage::StateStorage>(nullptr);
+        blockContext = std::make_shared<BlockContext>(
+            storage, hashImpl, 1, h256(), 0, 0, FiscoBcosScheduleV3, false, false);
+        executive = std::make_shared<TransactionExecutive>(
+            blockContext, "0000000000000000000000000000000000000001", 0, 0, gasInjector);
+
+        // PUSH1 1 PUSH1 2 ADD PUSH1 0 MSTORE PUSH1 32 PUSH1 0 RETURN, no host access
+        boost::algorithm::unhex(
+            std::string("600160020160005260206000f3"), std::back_inserter(code));
+    }
+
+    // Execute the code on vm and return the word it returns
+    u256 exec(VMInstance& vm)
+    {
+        auto callParameters = std::make_unique<CallParameters>(CallParameters::MESSAGE);
+        callParameters->gas = 100000;
+        HostContext hostContext(std::move(callParameters), executive,
+            executive->getContractTableName(executive->contractAddress()));
+
+        evmc_message message{};
+        message.kind = EVMC_CALL;
+        message.gas = 100000;
+        auto result = vm.exec(hostContext, EVMC_ISTANBUL, &message, code.data(), code.size());
+        if (result.status() != EVMC_SUCCESS || result.output().size() != 32)
+        {
+            return 0;
+        }
+        return fromBigEndian<u256>(result.output());
+    }
+
+    int count = 100000;
+    bytes code;
+    std::shared_ptr<Keccak256Hash> hashImpl;
+    std::shared_ptr<wasm::GasInjector> gasInjector;
+    std::shared_ptr<BlockContext> blockContext;
+    std::shared_ptr<TransactionExecutive> executive;
+};
+
+BOOST_FIXTURE_TEST_SUITE(testVMFactory, VMFactoryFixture)
+
+BOOST_AUTO_TEST_CASE(reuseInstance)
+{
+    // Use a new thread to start with an empty pool, Boost.Test isn't thread safe so the pool sizes
+    // are checked after join
+    std::vector<size_t> pooled;
+    std::thread([&pooled]() {
+        pooled.push_back(VMFactory::pooledInstances(VMKind::evmone));
+        {
+            auto vm = VMFactory::create(VMKind::evmone);
+            pooled.push_back(VMFactory::pooledInstances(VMKind::evmone));
+        }
+        pooled.push_back(VMFactory::pooledInstances(VMKind::evmone));
+        {
+            // nested frames borrow different instances
+            auto vm1 = VMFactory::create(VMKind::evmone);
+            auto vm2 = VMFactory::create(VMKind::evmone);
+            pooled.push_back(VMFactory::pooledInstances(VMKind::evmone));
+        }
+        pooled.push_back(VMFactory::pooledInstances(VMKind::evmone));
+        pooled.push_back(VMFactory::pooledInstances(VMKind::Hera));
+    }).join();
+
+    std::vector<size_t> expected{0, 0, 1, 0, 2, 0};
+    BOOST_CHECK_EQUAL_COLLECTIONS(pooled.begin(), pooled.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(maxPooledInstances)
+{
+    size_t pooled = 0;
+    std::thread([&pooled]() {
+        {
+            std::vector<std::unique_ptr<VMInstance>> vms;
+            for (size_t i = 0; i < VMFactory::c_maxPooledInstances + 4; ++i)
+            {
+                vms.emplace_back(new VMInstance(VMFactory::create(VMKind::evmone)));
+            }
+        }
+        pooled = VMFactory::pooledInstances(VMKind::evmone);
+    }).join();
+
+    BOOST_CHECK_EQUAL(pooled, VMFactory::c_maxPooledInstances);
+}
+
+BOOST_AUTO_TEST_CASE(execPooledInstance)
+{
+    // A reused instance keeps no state of the previous execution
+    for (int i = 0; i < 3; ++i)
+    {
+        auto vm = VMFactory::create(VMKind::evmone);
+        BOOST_CHECK_EQUAL(exec(vm), 3);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(createPerformance)
+{
+    // Every frame creates a vm and executes the code once, only the create/destroy cycle differs
+    u256 sum = 0;
+    auto start = chrono::system_clock::now();
+    for (int i = 0; i < count; ++i)
+    {
+        auto vm = VMInstance{evmc_create_evmone()};
+        sum += exec(vm);
+    }
+    auto end = chrono::system_clock::now();
+    cout << "evmone create/exec/destroy " << count << " times, time used(us)="
+         << chrono::duration_cast<chrono::microseconds>(end - start).count() << endl;
+
+    start = chrono::system_clock::now();
+    for (int i = 0; i < count; ++i)
+    {
+        auto vm = VMFactory::create(VMKind::evmone);
+        sum += exec(vm);
+    }
+    end = chrono::system_clock::now();
+    cout << "evmone pooled create/exec/recycle " << count << " times, time used(us)="
+         << chrono::duration_cast<chrono::microseconds>(end - start).count() << endl;
+
+    BOOST_CHECK_EQUAL(sum, u256(count) * 2 * 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace bcos::test